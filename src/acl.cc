@@ -0,0 +1,353 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "acl.h"
+#include "prefixlist.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+// Entries with more CIDR blocks are not expanded
+static const unsigned int MaxExpansionBits = 16;
+
+
+// ###### Parse IPv4 address token ##########################################
+static inline bool parseIPv4Token(const std::string& token, uint32_t& address)
+{
+   AddressValue value;
+   if(!parseIPv4Address(token.c_str(), token.size(), value)) {
+      return false;
+   }
+   address = (uint32_t)value.low;
+   return true;
+}
+
+
+// ###### Parse ACL entry ###################################################
+// Syntax: [permit|deny] any | host address | address/prefix |
+//                       address wildcard | address
+static bool parseAccessListEntry(const std::vector<std::string>& tokens,
+                                 AccessListEntry&                entry)
+{
+   size_t i     = 0;
+   entry.permit = true;
+   if( (tokens[i] == "permit") || (tokens[i] == "deny") ) {
+      entry.permit = (tokens[i] == "permit");
+      i++;
+   }
+   if(i >= tokens.size()) {
+      return false;
+   }
+
+   if( (tokens[i] == "any") && (i + 1 == tokens.size()) ) {
+      entry.address  = 0;
+      entry.wildcard = 0xffffffff;
+      return true;
+   }
+   if( (tokens[i] == "host") && (i + 2 == tokens.size()) ) {
+      entry.wildcard = 0;
+      return parseIPv4Token(tokens[i + 1], entry.address);
+   }
+   if( (tokens[i].find('/') != std::string::npos) && (i + 1 == tokens.size()) ) {
+      Prefix prefix;
+      if( (!parsePrefix(tokens[i].c_str(), prefix)) || (prefix.family != AF_INET) ) {
+         return false;
+      }
+      entry.address  = (uint32_t)prefix.network.low;
+      entry.wildcard = (uint32_t)hostMask<AF_INET>(prefix.length).low;
+      return true;
+   }
+   if(i + 1 == tokens.size()) {
+      entry.wildcard = 0;
+      return parseIPv4Token(tokens[i], entry.address);
+   }
+   if(i + 2 == tokens.size()) {
+      if( (!parseIPv4Token(tokens[i], entry.address)) ||
+          (!parseIPv4Token(tokens[i + 1], entry.wildcard)) ) {
+         return false;
+      }
+      entry.address &= ~entry.wildcard;
+      return true;
+   }
+   return false;
+}
+
+
+// ###### Constructor #######################################################
+AccessList::AccessList()
+{
+   Words = 0;
+}
+
+
+// ###### Read ACL from file ("-" for standard input) #######################
+// Comments start with "#" or "!"; "remark" lines are skipped as well.
+bool AccessList::read(const char* fileName)
+{
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(fileName, "-") != 0) {
+      fileStream.open(fileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   std::string              line;
+   unsigned int             lineNumber = 0;
+   std::vector<std::string> tokens;
+   AccessListEntry          entry;
+   while(std::getline(*is, line)) {
+      lineNumber++;
+      const size_t comment = line.find_first_of("#!");
+      if(comment != std::string::npos) {
+         line.resize(comment);
+      }
+      tokens.clear();
+      size_t begin = line.find_first_not_of(" \t\r");
+      while(begin != std::string::npos) {
+         const size_t end = line.find_first_of(" \t\r", begin);
+         tokens.push_back(line.substr(begin, end - begin));
+         begin = line.find_first_not_of(" \t\r", end);
+      }
+      if( (tokens.empty()) || (tokens[0] == "remark") ) {
+         continue;
+      }
+      if(!parseAccessListEntry(tokens, entry)) {
+         std::cerr << format(gettext("ERROR: Invalid ACL entry \"%s\" in %s, line %u!"),
+                             line.c_str(), fileName, lineNumber) << "\n";
+         return false;
+      }
+      Entries.push_back(entry);
+   }
+   compile();
+   return true;
+}
+
+
+// ###### Build bit vectors for the evaluation ##############################
+void AccessList::compile()
+{
+   Words = (Entries.size() + 63) / 64;
+   Table.assign(4 * 256 * Words, 0);
+   for(size_t e = 0; e < Entries.size(); e++) {
+      const uint64_t bit = 1ULL << (e % 64);
+      for(unsigned int position = 0; position < 4; position++) {
+         const unsigned int shift    = 24 - (8 * position);
+         const unsigned int address  = (Entries[e].address >> shift) & 0xff;
+         const unsigned int wildcard = (Entries[e].wildcard >> shift) & 0xff;
+         for(unsigned int value = 0; value < 256; value++) {
+            if(((value ^ address) & ~wildcard) == 0) {
+               Table[(((position * 256) + value) * Words) + (e / 64)] |= bit;
+            }
+         }
+      }
+   }
+}
+
+
+// ###### Get number of trailing contiguous wildcard bits ###################
+static inline unsigned int trailingWildcardBits(const uint32_t wildcard)
+{
+   return (wildcard == 0xffffffff) ? 32 : __builtin_ctz(~wildcard);
+}
+
+
+// ###### Get address string of a 32-bit value ##############################
+static inline std::string ipv4ToString(const uint32_t address)
+{
+   return addressValueToString(AF_INET, AddressValue { 0, address });
+}
+
+
+// ###### Print ACL entries with their address counts or CIDR blocks ########
+// The addresses matched by an entry are 2^(number of wildcard bits). The
+// trailing contiguous wildcard bits form the host part of a CIDR block; each
+// combination of the other wildcard bits gives one block. No CIDR set with
+// fewer blocks exists, since no block can span a fixed bit.
+bool printAccessList(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const char*        aclFileName,
+                     const bool         expand)
+{
+   AccessList acl;
+   if(!acl.read(aclFileName)) {
+      return false;
+   }
+
+   // ====== Print summary ==================================================
+   if(!expand) {
+      RecordWriter writer(os, outputFormat, { { "entry",         true  },
+                                              { "action",        false },
+                                              { "address",       false },
+                                              { "wildcard",      false },
+                                              { "addresses",     true  },
+                                              { "prefixes",      true  },
+                                              { "prefix_length", true  } });
+      for(size_t e = 0; e < acl.size(); e++) {
+         const AccessListEntry& entry    = acl[e];
+         const unsigned int     wildBits = __builtin_popcount(entry.wildcard);
+         const unsigned int     hostBits = trailingWildcardBits(entry.wildcard);
+         writer.write({ std::to_string(e + 1),
+                        (entry.permit) ? "permit" : "deny",
+                        ipv4ToString(entry.address),
+                        ipv4ToString(entry.wildcard),
+                        std::to_string(1ULL << wildBits),
+                        std::to_string(1ULL << (wildBits - hostBits)),
+                        std::to_string(32 - hostBits) });
+      }
+      return true;
+   }
+
+   // ====== Print CIDR blocks ==============================================
+   RecordWriter writer(os, outputFormat, { { "entry",  true  },
+                                           { "action", false },
+                                           { "prefix", false } });
+   for(size_t e = 0; e < acl.size(); e++) {
+      const AccessListEntry& entry    = acl[e];
+      const unsigned int     hostBits = trailingWildcardBits(entry.wildcard);
+      const uint32_t         hostPart = (hostBits == 32) ?
+                                           0xffffffff : ((1U << hostBits) - 1);
+      const uint32_t         varying  = entry.wildcard & ~hostPart;
+      const unsigned int     varBits  = __builtin_popcount(varying);
+      if(varBits > MaxExpansionBits) {
+         std::cerr << format(gettext("WARNING: Not expanding ACL entry %u, since it needs %llu prefixes!"),
+                             (unsigned int)(e + 1), 1ULL << varBits) << "\n";
+         continue;
+      }
+      const std::string entryString = std::to_string(e + 1);
+      const char*       action      = (entry.permit) ? "permit" : "deny";
+      Prefix            block       = { { 0, 0 }, AF_INET, (uint8_t)(32 - hostBits), 0 };
+      // Enumerate all subsets of the varying bits, in ascending order:
+      uint32_t subset = 0;
+      do {
+         block.network.low = entry.address | subset;
+         writer.write({ entryString, action, prefixToString(block) });
+         subset = (subset - varying) & varying;
+      } while(subset != 0);
+   }
+   return true;
+}
+
+
+// ###### Match addresses against ACL #######################################
+// Every address is evaluated with first-match semantics, and the matches
+// are counted per entry. Addresses matching no entry are counted for the
+// implicit "deny any" at the end, printed as entry 0.
+bool printAccessListMatches(std::ostream&      os,
+                            const OutputFormat outputFormat,
+                            const char*        aclFileName,
+                            const char*        addressListFileName)
+{
+   AccessList acl;
+   if(!acl.read(aclFileName)) {
+      return false;
+   }
+
+   // ====== Match addresses ================================================
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(addressListFileName, "-") != 0) {
+      fileStream.open(addressListFileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), addressListFileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   std::vector<unsigned long long> hits(acl.size() + 1, 0);
+   unsigned long long              ignored    = 0;
+   unsigned long long              prefixes   = 0;
+   unsigned int                    lineNumber = 0;
+   std::string                     line;
+   AddressValue                    value;
+   Prefix                          prefix;
+   while(std::getline(*is, line)) {
+      lineNumber++;
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      size_t end = line.find_first_of(" \t\r,#", begin);
+      if(end == std::string::npos) {
+         end = line.size();
+      }
+      if(parseIPv4Address(line.c_str() + begin, end - begin, value)) {
+         hits[acl.match((uint32_t)value.low)]++;
+      }
+      else {
+         line.resize(end);
+         if(!parsePrefix(line.c_str() + begin, prefix)) {
+            std::cerr << format(gettext("ERROR: Invalid address %s in %s, line %u!"),
+                                line.c_str() + begin, addressListFileName, lineNumber) << "\n";
+            return false;
+         }
+         if(prefix.family == AF_INET) {
+            prefixes++;
+         }
+         else {
+            ignored++;   // IPv6 address or prefix
+         }
+      }
+   }
+   if(prefixes > 0) {
+      std::cerr << format(gettext("WARNING: Ignoring %llu IPv4 prefixes in %s, since only addresses can be matched!"),
+                          prefixes, addressListFileName) << "\n";
+   }
+   if(ignored > 0) {
+      std::cerr << format(gettext("WARNING: Ignoring %llu entries in %s, since they are not IPv4 addresses!"),
+                          ignored, addressListFileName) << "\n";
+   }
+
+   // ====== Print hits =====================================================
+   RecordWriter writer(os, outputFormat, { { "entry",    true  },
+                                           { "action",   false },
+                                           { "address",  false },
+                                           { "wildcard", false },
+                                           { "hits",     true  } });
+   for(size_t e = 0; e < acl.size(); e++) {
+      const AccessListEntry& entry = acl[e];
+      writer.write({ std::to_string(e + 1),
+                     (entry.permit) ? "permit" : "deny",
+                     ipv4ToString(entry.address),
+                     ipv4ToString(entry.wildcard),
+                     std::to_string(hits[e]) });
+   }
+   writer.write({ "0", "deny", "0.0.0.0", "255.255.255.255",
+                  std::to_string(hits[acl.size()]) });
+   return true;
+}
@@ -0,0 +1,107 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef ACL_H
+#define ACL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "output.h"
+
+
+// ###### Entry of an access control list ###################################
+// Like in Cisco-style ACLs, 1-bits of the wildcard mask are "don't care"
+// bits. They do not need to be contiguous.
+struct AccessListEntry {
+   uint32_t address;    // Normalised: all wildcard bits are 0
+   uint32_t wildcard;
+   bool     permit;
+};
+
+
+// ###### IPv4 access control list with first-match evaluation ##############
+// The evaluation is bit-sliced by octet: for each octet position and octet
+// value, a bit vector marks the entries accepting that value. The AND of
+// the four vectors of an address marks all matching entries, and its
+// lowest 1-bit is the first match.
+class AccessList
+{
+   public:
+   AccessList();
+
+   bool read(const char* fileName);
+
+   inline size_t size() const {
+      return Entries.size();
+   }
+   inline const AccessListEntry& operator[](const size_t index) const {
+      return Entries[index];
+   }
+
+   // Returns the index of the first matching entry, or size() if there is
+   // no matching entry.
+   inline size_t match(const uint32_t address) const {
+      if(Words == 0) {
+         return Entries.size();   // Empty list: no table
+      }
+      const uint64_t* v0 = &Table[((0 * 256) + (address >> 24)) * Words];
+      const uint64_t* v1 = &Table[((1 * 256) + ((address >> 16) & 0xff)) * Words];
+      const uint64_t* v2 = &Table[((2 * 256) + ((address >> 8) & 0xff)) * Words];
+      const uint64_t* v3 = &Table[((3 * 256) + (address & 0xff)) * Words];
+      for(size_t i = 0; i < Words; i++) {
+         const uint64_t matching = v0[i] & v1[i] & v2[i] & v3[i];
+         if(matching != 0) {
+            return (i * 64) + __builtin_ctzll(matching);
+         }
+      }
+      return Entries.size();
+   }
+
+   private:
+   void compile();
+
+   std::vector<AccessListEntry> Entries;
+   size_t                       Words;   // 64-bit words per bit vector
+   std::vector<uint64_t>        Table;   // [octet position][octet value][word]
+};
+
+
+bool printAccessList(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const char*        aclFileName,
+                     const bool         expand);
+bool printAccessListMatches(std::ostream&      os,
+                            const OutputFormat outputFormat,
+                            const char*        aclFileName,
+                            const char*        addressListFileName);
+
+#endif
@@ -0,0 +1,358 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "addressarray.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+// The AVX2 kernels are compiled for AVX2 only, and used when the CPU
+// supports it. So, the rest of the program remains usable on any x86 CPU.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HAVE_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+
+// ###### IPv4 kernel: SSE2 (if available) and scalar #######################
+static void computeIPv4RangesBaseline(const uint32_t* address,
+                                      const uint8_t*  length,
+                                      const size_t    count,
+                                      uint32_t*       network,
+                                      uint32_t*       broadcast,
+                                      uint32_t*       wildcard,
+                                      uint32_t*       firstHost,
+                                      uint32_t*       lastHost)
+{
+   size_t i = 0;
+#if defined(__SSE2__)
+   // There are no per-lane shifts in SSE2: the netmasks are set up in
+   // scalar code, the rest is computed in 4 lanes.
+   const __m128i ones = _mm_set1_epi32(-1);
+   const __m128i c31  = _mm_set1_epi32(31);
+   const __m128i c1   = _mm_set1_epi32(1);
+   for( ; i + 4 <= count; i += 4) {
+      const __m128i a        = _mm_loadu_si128((const __m128i*)&address[i]);
+      const __m128i len      = _mm_set_epi32(length[i + 3], length[i + 2],
+                                             length[i + 1], length[i]);
+      const __m128i mask     = _mm_set_epi32((int)(uint32_t)netMask<AF_INET>(length[i + 3]).low,
+                                             (int)(uint32_t)netMask<AF_INET>(length[i + 2]).low,
+                                             (int)(uint32_t)netMask<AF_INET>(length[i + 1]).low,
+                                             (int)(uint32_t)netMask<AF_INET>(length[i]).low);
+      const __m128i net      = _mm_and_si128(a, mask);
+      const __m128i wild     = _mm_xor_si128(mask, ones);
+      const __m128i bcast    = _mm_or_si128(net, wild);
+      const __m128i reserved = _mm_and_si128(_mm_cmpgt_epi32(c31, len), c1);
+      _mm_storeu_si128((__m128i*)&network[i],   net);
+      _mm_storeu_si128((__m128i*)&broadcast[i], bcast);
+      _mm_storeu_si128((__m128i*)&wildcard[i],  wild);
+      _mm_storeu_si128((__m128i*)&firstHost[i], _mm_or_si128(net, reserved));
+      _mm_storeu_si128((__m128i*)&lastHost[i],  _mm_andnot_si128(reserved, bcast));
+   }
+#endif
+   for( ; i < count; i++) {
+      const uint32_t mask     = (uint32_t)netMask<AF_INET>(length[i]).low;
+      const uint32_t reserved = (length[i] < 31) ? 1 : 0;
+      network[i]   = address[i] & mask;
+      wildcard[i]  = ~mask;
+      broadcast[i] = network[i] | wildcard[i];
+      firstHost[i] = network[i] | reserved;
+      lastHost[i]  = broadcast[i] & ~reserved;
+   }
+}
+
+
+// ###### IPv6 kernel: scalar ###############################################
+// With SSE2, a register holds just one address, and there are no per-lane
+// shifts. So, SSE2 would not be faster than the scalar code.
+static void computeIPv6RangesBaseline(const AddressValue* address,
+                                      const uint8_t*      length,
+                                      const size_t        count,
+                                      AddressValue*       network,
+                                      AddressValue*       lastAddress,
+                                      AddressValue*       wildcard,
+                                      AddressValue*       firstHost)
+{
+   for(size_t i = 0; i < count; i++) {
+      const unsigned int l    = length[i];
+      const AddressValue host = hostMask<AF_INET6>(l);
+      network[i]     = AddressValue { address[i].high & ~host.high,
+                                      address[i].low & ~host.low };
+      wildcard[i]    = host;
+      lastAddress[i] = network[i] | host;
+      firstHost[i]   = AddressValue { network[i].high,
+                                      network[i].low | ((l < 128) ? 1 : 0) };
+   }
+}
+
+
+#if defined(HAVE_AVX2_KERNELS)
+// ###### IPv4 kernel: AVX2 #################################################
+__attribute__((target("avx2")))
+static void computeIPv4RangesAVX2(const uint32_t* address,
+                                  const uint8_t*  length,
+                                  const size_t    count,
+                                  uint32_t*       network,
+                                  uint32_t*       broadcast,
+                                  uint32_t*       wildcard,
+                                  uint32_t*       firstHost,
+                                  uint32_t*       lastHost)
+{
+   const __m256i ones = _mm256_set1_epi32(-1);
+   const __m256i c32  = _mm256_set1_epi32(32);
+   const __m256i c31  = _mm256_set1_epi32(31);
+   const __m256i c1   = _mm256_set1_epi32(1);
+   size_t i = 0;
+   for( ; i + 8 <= count; i += 8) {
+      const __m256i a        = _mm256_loadu_si256((const __m256i*)&address[i]);
+      const __m256i len      = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&length[i]));
+      // A shift by 32 results in 0, i.e. the netmask of /0:
+      const __m256i mask     = _mm256_sllv_epi32(ones, _mm256_sub_epi32(c32, len));
+      const __m256i net      = _mm256_and_si256(a, mask);
+      const __m256i wild     = _mm256_xor_si256(mask, ones);
+      const __m256i bcast    = _mm256_or_si256(net, wild);
+      const __m256i reserved = _mm256_and_si256(_mm256_cmpgt_epi32(c31, len), c1);
+      _mm256_storeu_si256((__m256i*)&network[i],   net);
+      _mm256_storeu_si256((__m256i*)&broadcast[i], bcast);
+      _mm256_storeu_si256((__m256i*)&wildcard[i],  wild);
+      _mm256_storeu_si256((__m256i*)&firstHost[i], _mm256_or_si256(net, reserved));
+      _mm256_storeu_si256((__m256i*)&lastHost[i],  _mm256_andnot_si256(reserved, bcast));
+   }
+   computeIPv4RangesBaseline(&address[i], &length[i], count - i,
+                             &network[i], &broadcast[i], &wildcard[i],
+                             &firstHost[i], &lastHost[i]);
+}
+
+
+// ###### IPv6 kernel: AVX2 #################################################
+// A register holds two addresses, as 64-bit lanes high0, low0, high1, low1.
+__attribute__((target("avx2")))
+static void computeIPv6RangesAVX2(const AddressValue* address,
+                                  const uint8_t*      length,
+                                  const size_t        count,
+                                  AddressValue*       network,
+                                  AddressValue*       lastAddress,
+                                  AddressValue*       wildcard,
+                                  AddressValue*       firstHost)
+{
+   static_assert(sizeof(AddressValue) == 16, "AddressValue must be 128 bits");
+   const __m256i ones = _mm256_set1_epi64x(-1);
+   size_t i = 0;
+   for( ; i + 2 <= count; i += 2) {
+      const long long l0 = length[i];
+      const long long l1 = length[i + 1];
+      // A shift by 64 or more results in 0:
+      const __m256i shift    = _mm256_set_epi64x((l1 > 64) ? (l1 - 64) : 0, l1,
+                                                 (l0 > 64) ? (l0 - 64) : 0, l0);
+      const __m256i reserved = _mm256_set_epi64x((l1 < 128) ? 1 : 0, 0,
+                                                 (l0 < 128) ? 1 : 0, 0);
+      const __m256i a        = _mm256_loadu_si256((const __m256i*)&address[i]);
+      const __m256i host     = _mm256_srlv_epi64(ones, shift);
+      const __m256i net      = _mm256_andnot_si256(host, a);
+      _mm256_storeu_si256((__m256i*)&network[i],     net);
+      _mm256_storeu_si256((__m256i*)&lastAddress[i], _mm256_or_si256(net, host));
+      _mm256_storeu_si256((__m256i*)&wildcard[i],    host);
+      _mm256_storeu_si256((__m256i*)&firstHost[i],   _mm256_or_si256(net, reserved));
+   }
+   computeIPv6RangesBaseline(&address[i], &length[i], count - i,
+                             &network[i], &lastAddress[i], &wildcard[i],
+                             &firstHost[i]);
+}
+#endif
+
+
+// ###### Check whether the CPU supports AVX2 ###############################
+static bool haveAVX2()
+{
+#if defined(HAVE_AVX2_KERNELS)
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("avx2");
+#else
+   return false;
+#endif
+}
+
+
+// ###### Compute IPv4 network, broadcast, wildcard and host range ##########
+void computeIPv4Ranges(const uint32_t* address,
+                       const uint8_t*  length,
+                       const size_t    count,
+                       uint32_t*       network,
+                       uint32_t*       broadcast,
+                       uint32_t*       wildcard,
+                       uint32_t*       firstHost,
+                       uint32_t*       lastHost)
+{
+   typedef void (*Kernel)(const uint32_t*, const uint8_t*, const size_t,
+                          uint32_t*, uint32_t*, uint32_t*, uint32_t*, uint32_t*);
+#if defined(HAVE_AVX2_KERNELS)
+   static const Kernel kernel = (haveAVX2()) ? computeIPv4RangesAVX2 :
+                                               computeIPv4RangesBaseline;
+#else
+   static const Kernel kernel = computeIPv4RangesBaseline;
+#endif
+   kernel(address, length, count, network, broadcast, wildcard, firstHost, lastHost);
+}
+
+
+// ###### Compute IPv6 network, last address, wildcard and first host #######
+void computeIPv6Ranges(const AddressValue* address,
+                       const uint8_t*      length,
+                       const size_t        count,
+                       AddressValue*       network,
+                       AddressValue*       lastAddress,
+                       AddressValue*       wildcard,
+                       AddressValue*       firstHost)
+{
+   typedef void (*Kernel)(const AddressValue*, const uint8_t*, const size_t,
+                          AddressValue*, AddressValue*, AddressValue*, AddressValue*);
+#if defined(HAVE_AVX2_KERNELS)
+   static const Kernel kernel = (haveAVX2()) ? computeIPv6RangesAVX2 :
+                                               computeIPv6RangesBaseline;
+#else
+   static const Kernel kernel = computeIPv6RangesBaseline;
+#endif
+   kernel(address, length, count, network, lastAddress, wildcard, firstHost);
+}
+
+
+// ###### Read addresses with prefix length ("-" for standard input) ########
+static bool readAddressArray(const char* fileName, AddressArray& addressArray)
+{
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(fileName, "-") != 0) {
+      fileStream.open(fileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   std::string  line;
+   unsigned int lineNumber = 0;
+   AddressValue address;
+   unsigned int family;
+   unsigned int length;
+   while(std::getline(*is, line)) {
+      lineNumber++;
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      const size_t end = line.find_first_of(" \t\r,#", begin);
+      if(end != std::string::npos) {
+         line.resize(end);
+      }
+      if(!parseAddressPrefix(line.c_str() + begin, address, family, length)) {
+         std::cerr << format(gettext("ERROR: Invalid address %s in %s, line %u!"),
+                             line.c_str() + begin, fileName, lineNumber) << "\n";
+         return false;
+      }
+      addressArray.push(family, address, length);
+   }
+   return true;
+}
+
+
+// ###### Print network, broadcast, wildcard and host range in bulk #########
+// The addresses are read into an AddressArray, and the kernels compute the
+// results for each address family at once. The results are printed in the
+// input order. IPv6 has no broadcast address, so this field is empty.
+bool printAddressRanges(std::ostream&      os,
+                        const OutputFormat outputFormat,
+                        const char*        addressListFileName)
+{
+   AddressArray addressArray;
+   if(!readAddressArray(addressListFileName, addressArray)) {
+      return false;
+   }
+
+   // ====== Compute IPv4 results ===========================================
+   const size_t          ipv4Count = addressArray.IPv4Address.size();
+   std::vector<uint32_t> ipv4Network(ipv4Count);
+   std::vector<uint32_t> ipv4Broadcast(ipv4Count);
+   std::vector<uint32_t> ipv4Wildcard(ipv4Count);
+   std::vector<uint32_t> ipv4FirstHost(ipv4Count);
+   std::vector<uint32_t> ipv4LastHost(ipv4Count);
+   computeIPv4Ranges(addressArray.IPv4Address.data(), addressArray.IPv4Length.data(),
+                     ipv4Count, ipv4Network.data(), ipv4Broadcast.data(),
+                     ipv4Wildcard.data(), ipv4FirstHost.data(), ipv4LastHost.data());
+
+   // ====== Compute IPv6 results ===========================================
+   const size_t              ipv6Count = addressArray.IPv6Address.size();
+   std::vector<AddressValue> ipv6Network(ipv6Count);
+   std::vector<AddressValue> ipv6LastAddress(ipv6Count);
+   std::vector<AddressValue> ipv6Wildcard(ipv6Count);
+   std::vector<AddressValue> ipv6FirstHost(ipv6Count);
+   computeIPv6Ranges(addressArray.IPv6Address.data(), addressArray.IPv6Length.data(),
+                     ipv6Count, ipv6Network.data(), ipv6LastAddress.data(),
+                     ipv6Wildcard.data(), ipv6FirstHost.data());
+
+   // ====== Print results in input order ===================================
+   RecordWriter writer(os, outputFormat, { { "address",       false },
+                                           { "prefix_length", true  },
+                                           { "network",       false },
+                                           { "broadcast",     false },
+                                           { "wildcard",      false },
+                                           { "first_host",    false },
+                                           { "last_host",     false } });
+   size_t i4 = 0;
+   size_t i6 = 0;
+   for(const uint8_t family : addressArray.Family) {
+      if(family == AF_INET) {
+         writer.write({ addressValueToString(AF_INET, AddressValue { 0, addressArray.IPv4Address[i4] }),
+                        std::to_string(addressArray.IPv4Length[i4]),
+                        addressValueToString(AF_INET, AddressValue { 0, ipv4Network[i4] }),
+                        addressValueToString(AF_INET, AddressValue { 0, ipv4Broadcast[i4] }),
+                        addressValueToString(AF_INET, AddressValue { 0, ipv4Wildcard[i4] }),
+                        addressValueToString(AF_INET, AddressValue { 0, ipv4FirstHost[i4] }),
+                        addressValueToString(AF_INET, AddressValue { 0, ipv4LastHost[i4] }) });
+         i4++;
+      }
+      else {
+         writer.write({ addressValueToString(AF_INET6, addressArray.IPv6Address[i6]),
+                        std::to_string(addressArray.IPv6Length[i6]),
+                        addressValueToString(AF_INET6, ipv6Network[i6]),
+                        "",
+                        addressValueToString(AF_INET6, ipv6Wildcard[i6]),
+                        addressValueToString(AF_INET6, ipv6FirstHost[i6]),
+                        addressValueToString(AF_INET6, ipv6LastAddress[i6]) });
+         i6++;
+      }
+   }
+   return true;
+}
@@ -0,0 +1,94 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef ADDRESSARRAY_H
+#define ADDRESSARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "output.h"
+#include "prefixlist.h"
+
+
+// ###### Structure-of-arrays container for addresses with prefix length ####
+// Unlike sockaddr_union, only the address bits and the prefix length are
+// stored, in separate arrays per address family. So, the kernels below
+// process whole arrays without any per-address branches.
+struct AddressArray {
+   std::vector<uint32_t>     IPv4Address;
+   std::vector<uint8_t>      IPv4Length;
+   std::vector<AddressValue> IPv6Address;
+   std::vector<uint8_t>      IPv6Length;
+   std::vector<uint8_t>      Family;   // Families in insertion order
+
+   inline void push(const unsigned int  family,
+                    const AddressValue& address,
+                    const unsigned int  length) {
+      if(family == AF_INET) {
+         IPv4Address.push_back((uint32_t)address.low);
+         IPv4Length.push_back((uint8_t)length);
+      }
+      else {
+         IPv6Address.push_back(address);
+         IPv6Length.push_back((uint8_t)length);
+      }
+      Family.push_back((uint8_t)family);
+   }
+};
+
+
+// Host ranges are calculated like for a single address: for IPv4, the
+// network and broadcast addresses are not used for hosts, except for /31
+// and /32. For IPv6, only the Subnet-Router anycast address (the network
+// address) is not used, except for /128. The last IPv6 host is the last
+// address. The AVX2 or SSE2 kernels are selected at runtime.
+void computeIPv4Ranges(const uint32_t* address,
+                       const uint8_t*  length,
+                       const size_t    count,
+                       uint32_t*       network,
+                       uint32_t*       broadcast,
+                       uint32_t*       wildcard,
+                       uint32_t*       firstHost,
+                       uint32_t*       lastHost);
+void computeIPv6Ranges(const AddressValue* address,
+                       const uint8_t*      length,
+                       const size_t        count,
+                       AddressValue*       network,
+                       AddressValue*       lastAddress,
+                       AddressValue*       wildcard,
+                       AddressValue*       firstHost);
+
+bool printAddressRanges(std::ostream&      os,
+                        const OutputFormat outputFormat,
+                        const char*        addressListFileName);
+
+#endif
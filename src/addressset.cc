@@ -0,0 +1,488 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "addressset.h"
+#include "prefixlist.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+
+// ###### Set bits [first, last] of a bitmap, return number of new bits #####
+static unsigned int setBitRange(uint64_t*          bitmap,
+                                const unsigned int first,
+                                const unsigned int last)
+{
+   const unsigned int firstWord = first >> 6;
+   const unsigned int lastWord  = last >> 6;
+   unsigned int       added     = 0;
+   for(unsigned int w = firstWord; w <= lastWord; w++) {
+      uint64_t mask = ~0ULL;
+      if(w == firstWord) {
+         mask &= ~0ULL << (first & 63);
+      }
+      if(w == lastWord) {
+         mask &= ~0ULL >> (63 - (last & 63));
+      }
+      added += __builtin_popcountll(mask & ~bitmap[w]);
+      bitmap[w] |= mask;
+   }
+   return added;
+}
+
+
+// ###### Count bits [first, last] of a bitmap ##############################
+static unsigned int countBitRange(const uint64_t*    bitmap,
+                                  const unsigned int first,
+                                  const unsigned int last)
+{
+   const unsigned int firstWord = first >> 6;
+   const unsigned int lastWord  = last >> 6;
+   unsigned int       count     = 0;
+   for(unsigned int w = firstWord; w <= lastWord; w++) {
+      uint64_t mask = ~0ULL;
+      if(w == firstWord) {
+         mask &= ~0ULL << (first & 63);
+      }
+      if(w == lastWord) {
+         mask &= ~0ULL >> (63 - (last & 63));
+      }
+      count += __builtin_popcountll(bitmap[w] & mask);
+   }
+   return count;
+}
+
+
+// ###### Constructor #######################################################
+IPv4AddressSet::IPv4AddressSet(const bool dense)
+   : ChunkCardinality(ChunkSize, 0)
+{
+   DenseBitmap = nullptr;
+   if(dense) {
+      // calloc() maps zero pages lazily, i.e. untouched chunks need no memory.
+      DenseBitmap = (uint64_t*)calloc((size_t)ChunkSize * ChunkWords, sizeof(uint64_t));
+      if(DenseBitmap == nullptr) {
+         std::cerr << gettext("ERROR: Unable to allocate memory for dense bitmap!") << "\n";
+         exit(1);
+      }
+   }
+   else {
+      Containers.resize(ChunkSize);
+   }
+}
+
+
+// ###### Destructor ########################################################
+IPv4AddressSet::~IPv4AddressSet()
+{
+   free(DenseBitmap);
+}
+
+
+// ###### Insert address range within one chunk #############################
+void IPv4AddressSet::insertChunkRange(const unsigned int chunk,
+                                      const unsigned int first,
+                                      const unsigned int last)
+{
+   uint32_t& chunkCardinality = ChunkCardinality[chunk];
+   if(chunkCardinality == ChunkSize) {
+      return;
+   }
+
+   // ====== Dense mode =====================================================
+   if(DenseBitmap != nullptr) {
+      chunkCardinality += setBitRange(&DenseBitmap[(size_t)chunk * ChunkWords], first, last);
+      return;
+   }
+
+   // ====== Sparse mode ====================================================
+   Container& container = Containers[chunk];
+   if( (first == 0) && (last == ChunkSize - 1) ) {
+      container.Type = CT_Full;
+      container.Array.clear();
+      container.Array.shrink_to_fit();
+      container.Bitmap.reset();
+      chunkCardinality = ChunkSize;
+      return;
+   }
+
+   if(container.Type <= CT_Array) {
+      if(chunkCardinality + (last - first + 1) <= ArrayThreshold) {
+         // ------ Merge range into sorted array ----------------------------
+         if(first == last) {
+            auto found = std::lower_bound(container.Array.begin(), container.Array.end(),
+                                          (uint16_t)first);
+            if( (found == container.Array.end()) || (*found != first) ) {
+               container.Array.insert(found, (uint16_t)first);
+            }
+         }
+         else {
+            std::vector<uint16_t> range(last - first + 1);
+            for(unsigned int i = first; i <= last; i++) {
+               range[i - first] = (uint16_t)i;
+            }
+            std::vector<uint16_t> merged;
+            merged.reserve(container.Array.size() + range.size());
+            std::set_union(container.Array.begin(), container.Array.end(),
+                           range.begin(), range.end(), std::back_inserter(merged));
+            container.Array.swap(merged);
+         }
+         container.Type   = CT_Array;
+         chunkCardinality = container.Array.size();
+         return;
+      }
+
+      // ------ Convert array to bitmap -------------------------------------
+      container.Bitmap.reset(new uint64_t[ChunkWords]());
+      for(const uint16_t value : container.Array) {
+         container.Bitmap[value >> 6] |= (1ULL << (value & 63));
+      }
+      container.Array.clear();
+      container.Array.shrink_to_fit();
+      container.Type = CT_Bitmap;
+   }
+
+   chunkCardinality += setBitRange(container.Bitmap.get(), first, last);
+   if(chunkCardinality == ChunkSize) {
+      container.Type = CT_Full;
+      container.Bitmap.reset();
+   }
+}
+
+
+// ###### Insert address range ##############################################
+void IPv4AddressSet::insertRange(const uint32_t first, const uint32_t last)
+{
+   assert(first <= last);
+   const unsigned int firstChunk = first >> ChunkBits;
+   const unsigned int lastChunk  = last >> ChunkBits;
+   for(unsigned int chunk = firstChunk; chunk <= lastChunk; chunk++) {
+      insertChunkRange(chunk,
+                       (chunk == firstChunk) ? (first & (ChunkSize - 1)) : 0,
+                       (chunk == lastChunk)  ? (last  & (ChunkSize - 1)) : ChunkSize - 1);
+   }
+}
+
+
+// ###### Insert prefix #####################################################
+void IPv4AddressSet::insertPrefix(const uint32_t network, const unsigned int length)
+{
+   assert(length <= 32);
+   const uint32_t mask = (length == 0) ? 0 : (~0U << (32 - length));
+   insertRange(network & mask, (network & mask) | ~mask);
+}
+
+
+// ###### Check whether address is in set ###################################
+bool IPv4AddressSet::contains(const uint32_t address) const
+{
+   const unsigned int chunk = address >> ChunkBits;
+   const unsigned int value = address & (ChunkSize - 1);
+   if(DenseBitmap != nullptr) {
+      return (DenseBitmap[(size_t)chunk * ChunkWords + (value >> 6)] >> (value & 63)) & 1;
+   }
+   const Container& container = Containers[chunk];
+   switch(container.Type) {
+      case CT_Full:
+         return true;
+      case CT_Bitmap:
+         return (container.Bitmap[value >> 6] >> (value & 63)) & 1;
+      case CT_Array:
+         return std::binary_search(container.Array.begin(), container.Array.end(),
+                                   (uint16_t)value);
+   }
+   return false;
+}
+
+
+// ###### Get number of addresses in set ####################################
+uint64_t IPv4AddressSet::cardinality() const
+{
+   uint64_t sum = 0;
+   for(const uint32_t chunkCardinality : ChunkCardinality) {
+      sum += chunkCardinality;
+   }
+   return sum;
+}
+
+
+// ###### Get number of addresses in set within range [first, last] #########
+uint64_t IPv4AddressSet::cardinality(const uint32_t first, const uint32_t last) const
+{
+   assert(first <= last);
+   const unsigned int firstChunk = first >> ChunkBits;
+   const unsigned int lastChunk  = last >> ChunkBits;
+   uint64_t           sum        = 0;
+   for(unsigned int chunk = firstChunk; chunk <= lastChunk; chunk++) {
+      const unsigned int a = (chunk == firstChunk) ? (first & (ChunkSize - 1)) : 0;
+      const unsigned int b = (chunk == lastChunk)  ? (last  & (ChunkSize - 1)) : ChunkSize - 1;
+      const uint32_t     chunkCardinality = ChunkCardinality[chunk];
+      if( (chunkCardinality == 0) ||
+          ((a == 0) && (b == ChunkSize - 1)) || (chunkCardinality == ChunkSize) ) {
+         sum += (chunkCardinality == ChunkSize) ? (b - a + 1) : chunkCardinality;
+      }
+      else if(DenseBitmap != nullptr) {
+         sum += countBitRange(&DenseBitmap[(size_t)chunk * ChunkWords], a, b);
+      }
+      else {
+         const Container& container = Containers[chunk];
+         if(container.Type == CT_Bitmap) {
+            sum += countBitRange(container.Bitmap.get(), a, b);
+         }
+         else {
+            sum += std::upper_bound(container.Array.begin(), container.Array.end(), (uint16_t)b) -
+                   std::lower_bound(container.Array.begin(), container.Array.end(), (uint16_t)a);
+         }
+      }
+   }
+   return sum;
+}
+
+
+// ###### Get bitmap of chunk ###############################################
+void IPv4AddressSet::getChunkBitmap(const unsigned int chunk, uint64_t* bitmap) const
+{
+   if(DenseBitmap != nullptr) {
+      memcpy(bitmap, &DenseBitmap[(size_t)chunk * ChunkWords], ChunkWords * sizeof(uint64_t));
+      return;
+   }
+   const Container& container = Containers[chunk];
+   switch(container.Type) {
+      case CT_Full:
+         memset(bitmap, 0xff, ChunkWords * sizeof(uint64_t));
+         break;
+      case CT_Bitmap:
+         memcpy(bitmap, container.Bitmap.get(), ChunkWords * sizeof(uint64_t));
+         break;
+      default:
+         memset(bitmap, 0x00, ChunkWords * sizeof(uint64_t));
+         for(const uint16_t value : container.Array) {
+            bitmap[value >> 6] |= (1ULL << (value & 63));
+         }
+         break;
+   }
+}
+
+
+// ###### Set chunk from bitmap, choosing the best container ################
+void IPv4AddressSet::setChunkBitmap(const unsigned int chunk, const uint64_t* bitmap)
+{
+   unsigned int chunkCardinality = 0;
+   for(unsigned int w = 0; w < ChunkWords; w++) {
+      chunkCardinality += __builtin_popcountll(bitmap[w]);
+   }
+   ChunkCardinality[chunk] = chunkCardinality;
+
+   if(DenseBitmap != nullptr) {
+      memcpy(&DenseBitmap[(size_t)chunk * ChunkWords], bitmap, ChunkWords * sizeof(uint64_t));
+      return;
+   }
+   Container& container = Containers[chunk];
+   container.Array.clear();
+   if(chunkCardinality == 0) {
+      container.Type = CT_Empty;
+      container.Bitmap.reset();
+   }
+   else if(chunkCardinality == ChunkSize) {
+      container.Type = CT_Full;
+      container.Bitmap.reset();
+   }
+   else if(chunkCardinality <= ArrayThreshold) {
+      container.Type = CT_Array;
+      container.Bitmap.reset();
+      container.Array.reserve(chunkCardinality);
+      for(unsigned int w = 0; w < ChunkWords; w++) {
+         uint64_t word = bitmap[w];
+         while(word != 0) {
+            container.Array.push_back((uint16_t)((w << 6) | __builtin_ctzll(word)));
+            word &= word - 1;
+         }
+      }
+   }
+   else {
+      container.Type = CT_Bitmap;
+      if(!container.Bitmap) {
+         container.Bitmap.reset(new uint64_t[ChunkWords]);
+      }
+      memcpy(container.Bitmap.get(), bitmap, ChunkWords * sizeof(uint64_t));
+   }
+   container.Array.shrink_to_fit();
+}
+
+
+// ###### Union with other set ##############################################
+void IPv4AddressSet::unite(const IPv4AddressSet& other)
+{
+   uint64_t a[ChunkWords];
+   uint64_t b[ChunkWords];
+   for(unsigned int chunk = 0; chunk < ChunkSize; chunk++) {
+      if( (other.ChunkCardinality[chunk] == 0) ||
+          (ChunkCardinality[chunk] == ChunkSize) ) {
+         continue;
+      }
+      if(other.ChunkCardinality[chunk] == ChunkSize) {
+         insertChunkRange(chunk, 0, ChunkSize - 1);
+         continue;
+      }
+      other.getChunkBitmap(chunk, b);
+      if(ChunkCardinality[chunk] != 0) {
+         getChunkBitmap(chunk, a);
+         for(unsigned int w = 0; w < ChunkWords; w++) {
+            b[w] |= a[w];
+         }
+      }
+      setChunkBitmap(chunk, b);
+   }
+}
+
+
+// ###### Intersection with other set #######################################
+void IPv4AddressSet::intersect(const IPv4AddressSet& other)
+{
+   uint64_t a[ChunkWords];
+   uint64_t b[ChunkWords];
+   for(unsigned int chunk = 0; chunk < ChunkSize; chunk++) {
+      if( (ChunkCardinality[chunk] == 0) ||
+          (other.ChunkCardinality[chunk] == ChunkSize) ) {
+         continue;
+      }
+      if(other.ChunkCardinality[chunk] == 0) {
+         memset(a, 0x00, sizeof(a));
+      }
+      else {
+         getChunkBitmap(chunk, a);
+         other.getChunkBitmap(chunk, b);
+         for(unsigned int w = 0; w < ChunkWords; w++) {
+            a[w] &= b[w];
+         }
+      }
+      setChunkBitmap(chunk, a);
+   }
+}
+
+
+// ###### Read IPv4 prefix list into address set ############################
+static bool readAddressSet(const char* fileName, IPv4AddressSet& addressSet)
+{
+   std::vector<Prefix> prefixList;
+   if(!readPrefixList(fileName, prefixList)) {
+      return false;
+   }
+   unsigned long long ignored = 0;
+   for(const Prefix& prefix : prefixList) {
+      if(prefix.family == AF_INET) {
+         addressSet.insertPrefix((uint32_t)prefix.network.low, prefix.length);
+      }
+      else {
+         ignored++;
+      }
+   }
+   if(ignored > 0) {
+      std::cerr << format(gettext("WARNING: Ignoring %llu IPv6 prefixes in %s!"),
+                          ignored, fileName) << "\n";
+   }
+   return true;
+}
+
+
+// ###### Print IPv4 address space coverage of prefix lists #################
+bool printCoverage(std::ostream&      os,
+                   const OutputFormat outputFormat,
+                   const int          listFiles,
+                   char**             listFileNames,
+                   const bool         dense,
+                   const bool         intersection,
+                   const int          blockLength)
+{
+   // ====== Build the address set ==========================================
+   IPv4AddressSet addressSet(dense);
+   if(!readAddressSet(listFileNames[0], addressSet)) {
+      return false;
+   }
+   for(int i = 1; i < listFiles; i++) {
+      IPv4AddressSet otherSet;
+      if(!readAddressSet(listFileNames[i], otherSet)) {
+         return false;
+      }
+      if(intersection) {
+         addressSet.intersect(otherSet);
+      }
+      else {
+         addressSet.unite(otherSet);
+      }
+   }
+
+   // ====== Print covered /N blocks ========================================
+   if(blockLength >= 0) {
+      RecordWriter       writer(os, outputFormat, { { "prefix",  false },
+                                                     { "covered", true  },
+                                                     { "size",    true  } });
+      const unsigned int hostBits  = 32 - blockLength;
+      const uint64_t     blockSize = 1ULL << hostBits;
+      Prefix             block;
+      block.family = AF_INET;
+      block.length = blockLength;
+      block.source = 0;
+      for(uint64_t first = 0; first < (1ULL << 32); first += blockSize) {
+         // Skip empty 65536-address chunks quickly:
+         if( (blockSize < 65536) &&
+             (addressSet.cardinality((uint32_t)first, (uint32_t)first | 0xffff) == 0) ) {
+            first = (first | 0xffff) + 1 - blockSize;
+            continue;
+         }
+         const uint64_t covered = addressSet.cardinality((uint32_t)first,
+                                                         (uint32_t)(first + blockSize - 1));
+         if(covered > 0) {
+            block.network = AddressValue { 0, first };
+            writer.write({ prefixToString(block),
+                           std::to_string(covered), std::to_string(blockSize) });
+         }
+      }
+   }
+
+   // ====== Print summary ==================================================
+   else {
+      const uint64_t covered    = addressSet.cardinality();
+      const double   percentage = 100.0 * (double)covered / 4294967296.0;
+      if(outputFormat == OF_Text) {
+         os << format("%-14s = %llu   (%1.6f%% of 2^32)",
+                      gettext("Addresses"), (unsigned long long)covered, percentage) << "\n";
+      }
+      else {
+         RecordWriter writer(os, outputFormat, { { "addresses",  true },
+                                                 { "percentage", true } });
+         writer.write({ std::to_string(covered), format("%1.6f", percentage) });
+      }
+   }
+   return true;
+}
@@ -0,0 +1,103 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef ADDRESSSET_H
+#define ADDRESSSET_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "output.h"
+
+
+// ###### Set of IPv4 addresses #############################################
+// The address space is split into 65536 chunks of 65536 addresses each.
+// In sparse mode, each chunk is stored in roaring bitmap style as either an
+// empty, sorted array, bitmap or full container. In dense mode, a single
+// 512 MiB bitmap covers the whole address space.
+class IPv4AddressSet
+{
+   public:
+   IPv4AddressSet(const bool dense = false);
+   ~IPv4AddressSet();
+
+   void insertRange(const uint32_t first, const uint32_t last);
+   void insertPrefix(const uint32_t network, const unsigned int length);
+   bool contains(const uint32_t address) const;
+   uint64_t cardinality() const;
+   uint64_t cardinality(const uint32_t first, const uint32_t last) const;
+
+   void unite(const IPv4AddressSet& other);
+   void intersect(const IPv4AddressSet& other);
+
+   inline bool isDense() const {
+      return DenseBitmap != nullptr;
+   }
+
+   private:
+   static const unsigned int ChunkBits      = 16;
+   static const unsigned int ChunkSize      = 1 << ChunkBits;
+   static const unsigned int ChunkWords     = ChunkSize / 64;
+   static const unsigned int ArrayThreshold = 4096;
+
+   enum ContainerType {
+      CT_Empty  = 0,
+      CT_Array  = 1,
+      CT_Bitmap = 2,
+      CT_Full   = 3
+   };
+   struct Container {
+      uint8_t                     Type = CT_Empty;
+      std::vector<uint16_t>       Array;
+      std::unique_ptr<uint64_t[]> Bitmap;
+   };
+
+   void getChunkBitmap(const unsigned int chunk, uint64_t* bitmap) const;
+   void setChunkBitmap(const unsigned int chunk, const uint64_t* bitmap);
+   void insertChunkRange(const unsigned int chunk,
+                         const unsigned int first,
+                         const unsigned int last);
+
+   uint64_t*              DenseBitmap;
+   std::vector<Container> Containers;
+   std::vector<uint32_t>  ChunkCardinality;
+};
+
+
+bool printCoverage(std::ostream&      os,
+                   const OutputFormat outputFormat,
+                   const int          listFiles,
+                   char**             listFileNames,
+                   const bool         dense,
+                   const bool         intersection,
+                   const int          blockLength);
+
+#endif
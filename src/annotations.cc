@@ -0,0 +1,493 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "annotations.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+
+// ###### Index file header #################################################
+// The file is written in native byte order; ByteOrder detects files of
+// another byte order. The header is followed by:
+// - ColumnNames: uint32_t[Columns] (string offsets),
+// - Values:      uint32_t[Records * Columns] (string offsets),
+// - IPv4Start:   uint32_t[IPv4Segments], IPv4Record: uint32_t[IPv4Segments],
+// - IPv6Start:   AddressValue[IPv6Segments], IPv6Record: uint32_t[IPv6Segments],
+// - Strings:     char[StringsSize] (NUL-terminated strings),
+// each section aligned to 8 bytes.
+struct AnnotationIndexHeader {
+   char     Magic[8];
+   uint32_t ByteOrder;
+   uint32_t Version;
+   uint32_t Columns;
+   uint32_t Records;
+   uint64_t IPv4Segments;
+   uint64_t IPv6Segments;
+   uint64_t StringsSize;
+};
+
+static const char     AnnotationIndexMagic[8] = { 'S', 'N', 'C', 'A', 'N', 'N', 'O', 0 };
+static const uint32_t AnnotationByteOrder     = 0x01020304;
+static const uint32_t AnnotationIndexVersion  = 1;
+static const uint32_t MaxAnnotationColumns    = 256;
+
+
+// ###### Offsets of the index file sections ################################
+struct AnnotationIndexLayout {
+   uint64_t ColumnNames;
+   uint64_t Values;
+   uint64_t IPv4Start;
+   uint64_t IPv4Record;
+   uint64_t IPv6Start;
+   uint64_t IPv6Record;
+   uint64_t Strings;
+   uint64_t Size;
+};
+
+
+// ###### Align offset to 8 bytes ###########################################
+static inline uint64_t align8(const uint64_t offset)
+{
+   return (offset + 7) & ~(uint64_t)7;
+}
+
+
+// ###### Compute offsets of the index file sections ########################
+// The counts have to be checked against the file size before, so that the
+// computation cannot overflow.
+static void computeLayout(const AnnotationIndexHeader& header,
+                          AnnotationIndexLayout&       layout)
+{
+   layout.ColumnNames = align8(sizeof(AnnotationIndexHeader));
+   layout.Values      = align8(layout.ColumnNames + (uint64_t)header.Columns * sizeof(uint32_t));
+   layout.IPv4Start   = align8(layout.Values +
+                               (uint64_t)header.Records * header.Columns * sizeof(uint32_t));
+   layout.IPv4Record  = align8(layout.IPv4Start + header.IPv4Segments * sizeof(uint32_t));
+   layout.IPv6Start   = align8(layout.IPv4Record + header.IPv4Segments * sizeof(uint32_t));
+   layout.IPv6Record  = align8(layout.IPv6Start + header.IPv6Segments * sizeof(AddressValue));
+   layout.Strings     = align8(layout.IPv6Record + header.IPv6Segments * sizeof(uint32_t));
+   layout.Size        = layout.Strings + header.StringsSize;
+}
+
+
+// ###### Constructor #######################################################
+AnnotationIndex::AnnotationIndex()
+{
+   Mapping     = nullptr;
+   MappingSize = 0;
+   Header      = nullptr;
+}
+
+
+// ###### Destructor ########################################################
+AnnotationIndex::~AnnotationIndex()
+{
+   if(Mapping != nullptr) {
+      munmap(Mapping, MappingSize);
+   }
+}
+
+
+// ###### Check segment starts ##############################################
+// The first segment has to start at the first address, and the starts have
+// to be strictly ascending, so that each address is in exactly one segment.
+template<typename T> static bool checkSegmentStarts(const T*       start,
+                                                    const uint64_t segments,
+                                                    const T&       first)
+{
+   if(start[0] != first) {
+      return false;
+   }
+   for(uint64_t i = 1; i < segments; i++) {
+      if(!(start[i - 1] < start[i])) {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+// ###### Open index file ###################################################
+// The header and the segment starts are checked. The string offsets and
+// record numbers are checked on access, so that a damaged file cannot cause
+// invalid reads.
+bool AnnotationIndex::open(const char* fileName)
+{
+   const int fd = ::open(fileName, O_RDONLY);
+   if(fd < 0) {
+      std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+      return false;
+   }
+   struct stat status;
+   if( (fstat(fd, &status) != 0) ||
+       ((uint64_t)status.st_size < sizeof(AnnotationIndexHeader)) ) {
+      ::close(fd);
+      std::cerr << format(gettext("ERROR: Invalid annotation index %s!"), fileName) << "\n";
+      return false;
+   }
+   MappingSize = (size_t)status.st_size;
+   Mapping     = mmap(nullptr, MappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+   ::close(fd);
+   if(Mapping == MAP_FAILED) {
+      Mapping = nullptr;
+      std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+      return false;
+   }
+
+   // ====== Check header ===================================================
+   const AnnotationIndexHeader* header = (const AnnotationIndexHeader*)Mapping;
+   AnnotationIndexLayout        layout;
+   const char*                  base   = (const char*)Mapping;
+   if( (memcmp(header->Magic, AnnotationIndexMagic, sizeof(header->Magic)) != 0) ||
+       (header->ByteOrder != AnnotationByteOrder) ||
+       (header->Version != AnnotationIndexVersion) ||
+       (header->Columns > MaxAnnotationColumns) ||
+       (header->IPv4Segments < 1) || (header->IPv4Segments > MappingSize) ||
+       (header->IPv6Segments < 1) || (header->IPv6Segments > MappingSize) ||
+       (header->StringsSize < 1) || (header->StringsSize > MappingSize) ||
+       ((computeLayout(*header, layout), layout.Size) != MappingSize) ||
+       (base[layout.Strings + header->StringsSize - 1] != 0x00) ||
+       (!checkSegmentStarts((const uint32_t*)(base + layout.IPv4Start),
+                            header->IPv4Segments, (uint32_t)0)) ||
+       (!checkSegmentStarts((const AddressValue*)(base + layout.IPv6Start),
+                            header->IPv6Segments, AddressValue { 0, 0 })) ) {
+      munmap(Mapping, MappingSize);
+      Mapping = nullptr;
+      std::cerr << format(gettext("ERROR: Invalid annotation index %s!"), fileName) << "\n";
+      return false;
+   }
+   Header      = header;
+   ColumnNames = (const uint32_t*)(base + layout.ColumnNames);
+   Values      = (const uint32_t*)(base + layout.Values);
+   IPv4Start   = (const uint32_t*)(base + layout.IPv4Start);
+   IPv4Record  = (const uint32_t*)(base + layout.IPv4Record);
+   IPv6Start   = (const AddressValue*)(base + layout.IPv6Start);
+   IPv6Record  = (const uint32_t*)(base + layout.IPv6Record);
+   Strings     = base + layout.Strings;
+   return true;
+}
+
+
+// ###### Look up address ###################################################
+uint32_t AnnotationIndex::lookup(const unsigned int  family,
+                                 const AddressValue& address) const
+{
+   if(Header == nullptr) {
+      return NoRecord;
+   }
+   // The first range starts at the first address (checked by open()), so
+   // there is always a range containing the address.
+   if(family == AF_INET) {
+      const uint32_t* end   = IPv4Start + Header->IPv4Segments;
+      const uint32_t* range = std::upper_bound(IPv4Start, end, (uint32_t)address.low) - 1;
+      return IPv4Record[range - IPv4Start];
+   }
+   const AddressValue* end   = IPv6Start + Header->IPv6Segments;
+   const AddressValue* range = std::upper_bound(IPv6Start, end, address) - 1;
+   return IPv6Record[range - IPv6Start];
+}
+
+
+// ###### Get number of columns #############################################
+unsigned int AnnotationIndex::columns() const
+{
+   return (Header != nullptr) ? Header->Columns : 0;
+}
+
+
+// ###### Get string of an offset ###########################################
+const char* AnnotationIndex::string(const uint32_t offset) const
+{
+   return (offset < Header->StringsSize) ? &Strings[offset] : "";
+}
+
+
+// ###### Get column name ###################################################
+const char* AnnotationIndex::columnName(const unsigned int column) const
+{
+   return (column < columns()) ? string(ColumnNames[column]) : "";
+}
+
+
+// ###### Get value of a record #############################################
+const char* AnnotationIndex::value(const uint32_t     record,
+                                   const unsigned int column) const
+{
+   if( (column >= columns()) || (record >= Header->Records) ) {
+      return "";
+   }
+   return string(Values[((size_t)record * Header->Columns) + column]);
+}
+
+
+// ###### Split CSV line into fields ########################################
+// Fields may be quoted with '"', a quote within a quoted field is "".
+static bool splitCSVLine(const std::string& line, std::vector<std::string>& fields)
+{
+   fields.clear();
+   fields.push_back(std::string());
+   bool quoted = false;
+   for(size_t i = 0; i < line.size(); i++) {
+      const char c = line[i];
+      if(quoted) {
+         if(c != '"') {
+            fields.back() += c;
+         }
+         else if( (i + 1 < line.size()) && (line[i + 1] == '"') ) {
+            fields.back() += c;
+            i++;
+         }
+         else {
+            quoted = false;
+         }
+      }
+      else if(c == '"') {
+         quoted = true;
+      }
+      else if(c == ',') {
+         fields.push_back(std::string());
+      }
+      else if(c != '\r') {
+         fields.back() += c;
+      }
+   }
+   return !quoted;
+}
+
+
+// ###### Convert sorted prefixes of one family into disjoint ranges ########
+// A stack holds the chain of prefixes containing the current one. Each
+// prefix starts a range with its record; when it ends, the range of its
+// supernet (or of no record) continues. Adjacent ranges of the same record
+// are merged.
+static void flattenPrefixes(const std::vector<Prefix>& prefixList,
+                            const unsigned int         family,
+                            std::vector<AddressValue>& starts,
+                            std::vector<uint32_t>&     records)
+{
+   auto addRange = [&](const AddressValue& start, const uint32_t record) {
+      if( (!starts.empty()) && (starts.back() == start) ) {
+         starts.pop_back();
+         records.pop_back();
+      }
+      if( (records.empty()) || (records.back() != record) ) {
+         starts.push_back(start);
+         records.push_back(record);
+      }
+   };
+
+   const AddressValue         lastOfFamily = hostMask(family, 0);
+   std::vector<const Prefix*> stack;
+   auto endPrefix = [&]() {
+      const AddressValue last = lastAddress(*stack.back());
+      stack.pop_back();
+      if(last != lastOfFamily) {
+         addRange(increment(last),
+                  (stack.empty()) ? AnnotationIndex::NoRecord : stack.back()->source);
+      }
+   };
+
+   addRange(AddressValue { 0, 0 }, AnnotationIndex::NoRecord);
+   for(const Prefix& prefix : prefixList) {
+      if(prefix.family != family) {
+         continue;
+      }
+      while( (!stack.empty()) && (!containsPrefix(*stack.back(), prefix)) ) {
+         endPrefix();
+      }
+      addRange(prefix.network, prefix.source);
+      stack.push_back(&prefix);
+   }
+   while(!stack.empty()) {
+      endPrefix();
+   }
+}
+
+
+// ###### Write section with padding to 8 bytes #############################
+static void writeSection(std::ofstream& os, const void* data, const uint64_t size)
+{
+   static const char padding[8] = { 0 };
+   os.write((const char*)data, size);
+   os.write(padding, align8(size) - size);
+}
+
+
+// ###### Compile CSV file into index file ##################################
+// The first line of the CSV file is the header: the name of the prefix
+// column, followed by the names of the metadata columns. Each further line
+// contains a prefix and its metadata. Empty lines and lines starting with
+// "#" are skipped. Nested prefixes are allowed; a lookup finds the longest
+// matching prefix.
+bool compileAnnotationIndex(const char* csvFileName,
+                            const char* indexFileName)
+{
+   std::ifstream is(csvFileName);
+   if(!is) {
+      std::cerr << format(gettext("ERROR: Unable to open %s!"), csvFileName) << "\n";
+      return false;
+   }
+
+   // ====== Read CSV file ==================================================
+   std::vector<char>                         strings(1, 0x00);   // "" has offset 0
+   std::unordered_map<std::string, uint32_t> stringOffsets;
+   auto intern = [&](const std::string& string) {
+      if(string.empty()) {
+         return (uint32_t)0;
+      }
+      const auto found = stringOffsets.find(string);
+      if(found != stringOffsets.end()) {
+         return found->second;
+      }
+      const uint32_t offset = (uint32_t)strings.size();
+      strings.insert(strings.end(), string.c_str(), string.c_str() + string.size() + 1);
+      stringOffsets.insert(std::make_pair(string, offset));
+      return offset;
+   };
+
+   std::vector<uint32_t>     columnNames;
+   std::vector<uint32_t>     values;
+   std::vector<Prefix>       prefixList;
+   std::vector<unsigned int> lineNumbers;
+   std::vector<std::string>  fields;
+   std::string               line;
+   unsigned int              lineNumber = 0;
+   size_t                    columns    = 0;
+   while(std::getline(is, line)) {
+      lineNumber++;
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      if( (!splitCSVLine(line, fields)) ||
+          ((columns > 0) && (fields.size() != columns + 1)) ) {
+         std::cerr << format(gettext("ERROR: Invalid line in %s, line %u!"),
+                             csvFileName, lineNumber) << "\n";
+         return false;
+      }
+      // ------ Header ------------------------------------------------------
+      if(columns == 0) {
+         if( (fields.size() < 2) || (fields.size() > MaxAnnotationColumns + 1) ) {
+            std::cerr << format(gettext("ERROR: Invalid header in %s, line %u!"),
+                                csvFileName, lineNumber) << "\n";
+            return false;
+         }
+         columns = fields.size() - 1;
+         for(size_t i = 1; i < fields.size(); i++) {
+            columnNames.push_back(intern(fields[i]));
+         }
+         continue;
+      }
+      // ------ Record ------------------------------------------------------
+      Prefix prefix;
+      if(!parsePrefix(fields[0].c_str(), prefix)) {
+         std::cerr << format(gettext("ERROR: Invalid prefix %s in %s, line %u!"),
+                             fields[0].c_str(), csvFileName, lineNumber) << "\n";
+         return false;
+      }
+      prefix.source = (uint32_t)prefixList.size();
+      prefixList.push_back(prefix);
+      lineNumbers.push_back(lineNumber);
+      for(size_t i = 1; i < fields.size(); i++) {
+         values.push_back(intern(fields[i]));
+      }
+   }
+   if( (columns == 0) || (strings.size() > 0xffffffffULL) ||
+       (prefixList.size() >= AnnotationIndex::NoRecord) ) {
+      std::cerr << format(gettext("ERROR: Invalid header in %s, line %u!"),
+                          csvFileName, lineNumber) << "\n";
+      return false;
+   }
+
+   // ====== Build ranges ===================================================
+   sortPrefixList(prefixList);
+   for(size_t i = 1; i < prefixList.size(); i++) {
+      if(prefixList[i] == prefixList[i - 1]) {
+         std::cerr << format(gettext("ERROR: Duplicate prefix %s in %s, line %u!"),
+                             prefixToString(prefixList[i]).c_str(), csvFileName,
+                             lineNumbers[prefixList[i].source]) << "\n";
+         return false;
+      }
+   }
+   std::vector<AddressValue> ipv4Starts;
+   std::vector<uint32_t>     ipv4Records;
+   std::vector<AddressValue> ipv6Starts;
+   std::vector<uint32_t>     ipv6Records;
+   flattenPrefixes(prefixList, AF_INET,  ipv4Starts, ipv4Records);
+   flattenPrefixes(prefixList, AF_INET6, ipv6Starts, ipv6Records);
+   std::vector<uint32_t> ipv4Starts32;
+   ipv4Starts32.reserve(ipv4Starts.size());
+   for(const AddressValue& start : ipv4Starts) {
+      ipv4Starts32.push_back((uint32_t)start.low);
+   }
+
+   // ====== Write index file ===============================================
+   AnnotationIndexHeader header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.Magic, AnnotationIndexMagic, sizeof(header.Magic));
+   header.ByteOrder    = AnnotationByteOrder;
+   header.Version      = AnnotationIndexVersion;
+   header.Columns      = (uint32_t)columns;
+   header.Records      = (uint32_t)prefixList.size();
+   header.IPv4Segments = ipv4Starts32.size();
+   header.IPv6Segments = ipv6Starts.size();
+   header.StringsSize  = strings.size();
+
+   std::ofstream os(indexFileName, std::ios::binary | std::ios::trunc);
+   if(!os) {
+      std::cerr << format(gettext("ERROR: Unable to create %s!"), indexFileName) << "\n";
+      return false;
+   }
+   writeSection(os, &header,             sizeof(header));
+   writeSection(os, columnNames.data(),  columnNames.size() * sizeof(uint32_t));
+   writeSection(os, values.data(),       values.size() * sizeof(uint32_t));
+   writeSection(os, ipv4Starts32.data(), ipv4Starts32.size() * sizeof(uint32_t));
+   writeSection(os, ipv4Records.data(),  ipv4Records.size() * sizeof(uint32_t));
+   writeSection(os, ipv6Starts.data(),   ipv6Starts.size() * sizeof(AddressValue));
+   writeSection(os, ipv6Records.data(),  ipv6Records.size() * sizeof(uint32_t));
+   os.write(strings.data(), strings.size());
+   os.close();
+   if(!os) {
+      std::cerr << format(gettext("ERROR: Unable to write %s!"), indexFileName) << "\n";
+      return false;
+   }
+   return true;
+}
@@ -0,0 +1,86 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef ANNOTATIONS_H
+#define ANNOTATIONS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "prefixlist.h"
+
+
+struct AnnotationIndexHeader;
+
+
+// ###### Read-only index of site-specific prefix annotations ###############
+// The index file is compiled from a CSV file with a prefix and metadata
+// columns (e.g. datacentre, VLAN, owner). It is memory-mapped as is: the
+// address space is stored as sorted, disjoint ranges, each referring to
+// the most specific prefix covering it, and all strings are interned. So,
+// opening the index does not need any parsing, and a lookup is a binary
+// search.
+class AnnotationIndex
+{
+   public:
+   static const uint32_t NoRecord = 0xffffffff;
+
+   AnnotationIndex();
+   ~AnnotationIndex();
+
+   bool open(const char* fileName);
+
+   // Returns the record of the longest matching prefix, or NoRecord.
+   uint32_t lookup(const unsigned int family, const AddressValue& address) const;
+
+   unsigned int columns() const;
+   const char* columnName(const unsigned int column) const;
+   const char* value(const uint32_t record, const unsigned int column) const;
+
+   private:
+   const char* string(const uint32_t offset) const;
+
+   void*                        Mapping;
+   size_t                       MappingSize;
+   const AnnotationIndexHeader* Header;
+   const uint32_t*              ColumnNames;
+   const uint32_t*              Values;
+   const uint32_t*              IPv4Start;
+   const uint32_t*              IPv4Record;
+   const AddressValue*          IPv6Start;
+   const uint32_t*              IPv6Record;
+   const char*                  Strings;
+};
+
+
+bool compileAnnotationIndex(const char* csvFileName,
+                            const char* indexFileName);
+
+#endif
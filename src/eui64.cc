@@ -0,0 +1,314 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "eui64.h"
+#include "multicast.h"
+#include "prefixlist.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+static const uint64_t UniversalLocalBit = 0x0200000000000000ULL;   // In the interface ID
+static const uint64_t EUI64Marker       = 0x000000fffe000000ULL;   // ff:fe in the middle
+static const uint64_t EUI64MarkerMask   = 0x000000ffff000000ULL;
+static const uint64_t UpperMACMask      = 0x0000ffffff000000ULL;
+static const uint64_t LowerMACMask      = 0x0000000000ffffffULL;
+
+
+// ###### Get value of hexadecimal digit ####################################
+static inline int hexValue(const char c)
+{
+   if( (c >= '0') && (c <= '9') ) {
+      return c - '0';
+   }
+   if( ((c | 0x20) >= 'a') && ((c | 0x20) <= 'f') ) {
+      return (c | 0x20) - 'a' + 10;
+   }
+   return -1;
+}
+
+
+// ###### Parse MAC address #################################################
+// Accepted formats: 00:11:22:33:44:55, 00-11-22-33-44-55, 0:11:22:3:44:55,
+// 0011.2233.4455 and 001122334455.
+bool parseMACAddress(const char* string, const size_t length, uint64_t& mac)
+{
+   char         separator = 0x00;
+   unsigned int groupSize;
+   unsigned int groups;
+   if(memchr(string, '.', length) != nullptr) {
+      separator = '.';
+      groupSize = 4;
+      groups    = 3;
+   }
+   else if( (length == 12) &&
+            (memchr(string, ':', length) == nullptr) &&
+            (memchr(string, '-', length) == nullptr) ) {
+      groupSize = 12;
+      groups    = 1;
+   }
+   else {
+      separator = (memchr(string, '-', length) != nullptr) ? '-' : ':';
+      groupSize = 2;
+      groups    = 6;
+   }
+
+   const char*  p   = string;
+   const char*  end = string + length;
+   uint64_t     value = 0;
+   for(unsigned int g = 0; g < groups; g++) {
+      if(g > 0) {
+         if( (p >= end) || (*p != separator) ) {
+            return false;
+         }
+         p++;
+      }
+      // ------ Group of hexadecimal digits (may be shortened for ":"/"-") --
+      unsigned int digits = 0;
+      uint64_t     group  = 0;
+      int          v;
+      while( (p < end) && (digits < groupSize) && ((v = hexValue(*p)) >= 0) ) {
+         group = (group << 4) | (uint64_t)v;
+         digits++;
+         p++;
+      }
+      if( (digits == 0) || ((separator != ':') && (separator != '-') && (digits != groupSize)) ) {
+         return false;
+      }
+      value = (value << (4 * groupSize)) | group;
+   }
+   if(p != end) {
+      return false;
+   }
+   mac = value;
+   return true;
+}
+
+
+// ###### Convert MAC address to string #####################################
+std::string macAddressToString(const uint64_t mac)
+{
+   static const char hexDigits[] = "0123456789abcdef";
+   char string[17];
+   for(unsigned int i = 0; i < 6; i++) {
+      const unsigned int octet = (unsigned int)(mac >> (40 - 8 * i)) & 0xff;
+      string[3 * i]     = hexDigits[octet >> 4];
+      string[3 * i + 1] = hexDigits[octet & 0x0f];
+      if(i < 5) {
+         string[3 * i + 2] = ':';
+      }
+   }
+   return std::string(string, sizeof(string));
+}
+
+
+// ###### Convert MAC addresses to modified EUI-64 interface IDs ############
+// RFC 4291, Appendix A: insert ff:fe in the middle and invert the
+// universal/local bit.
+void macsToInterfaceIDs(const uint64_t* macs,
+                        uint64_t*       interfaceIDs,
+                        const size_t    count)
+{
+   size_t i = 0;
+#if defined(__SSE2__)
+   const __m128i upperMask = _mm_set1_epi64x((long long)UpperMACMask);
+   const __m128i lowerMask = _mm_set1_epi64x((long long)LowerMACMask);
+   const __m128i constant  = _mm_set1_epi64x((long long)(EUI64Marker | UniversalLocalBit));
+   for( ; i + 2 <= count; i += 2) {
+      const __m128i m     = _mm_loadu_si128((const __m128i*)&macs[i]);
+      const __m128i upper = _mm_slli_epi64(_mm_and_si128(m, upperMask), 16);
+      const __m128i lower = _mm_and_si128(m, lowerMask);
+      _mm_storeu_si128((__m128i*)&interfaceIDs[i],
+                       _mm_xor_si128(_mm_or_si128(upper, lower), constant));
+   }
+#endif
+   for( ; i < count; i++) {
+      interfaceIDs[i] = (((macs[i] & UpperMACMask) << 16) | (macs[i] & LowerMACMask) |
+                         EUI64Marker) ^ UniversalLocalBit;
+   }
+}
+
+
+// ###### Extract MAC addresses from modified EUI-64 interface IDs ##########
+// isEUI64[i] is set to 0 for interface IDs not containing ff:fe.
+void interfaceIDsToMACs(const uint64_t* interfaceIDs,
+                        uint64_t*       macs,
+                        uint8_t*        isEUI64,
+                        const size_t    count)
+{
+   size_t i = 0;
+#if defined(__SSE2__)
+   const __m128i upperMask  = _mm_set1_epi64x((long long)(UpperMACMask << 16));
+   const __m128i lowerMask  = _mm_set1_epi64x((long long)LowerMACMask);
+   const __m128i markerMask = _mm_set1_epi64x((long long)EUI64MarkerMask);
+   const __m128i marker     = _mm_set1_epi64x((long long)EUI64Marker);
+   const __m128i ulBit      = _mm_set1_epi64x((long long)(UniversalLocalBit >> 16));
+   for( ; i + 2 <= count; i += 2) {
+      const __m128i id    = _mm_loadu_si128((const __m128i*)&interfaceIDs[i]);
+      const __m128i upper = _mm_srli_epi64(_mm_and_si128(id, upperMask), 16);
+      const __m128i lower = _mm_and_si128(id, lowerMask);
+      _mm_storeu_si128((__m128i*)&macs[i],
+                       _mm_xor_si128(_mm_or_si128(upper, lower), ulBit));
+      // ------ There is no 64-bit compare in SSE2: combine 32-bit halves --
+      __m128i equal = _mm_cmpeq_epi32(_mm_and_si128(id, markerMask), marker);
+      equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+      const int bits = _mm_movemask_epi8(equal);
+      isEUI64[i]     = (bits & 0x00ff) == 0x00ff;
+      isEUI64[i + 1] = (bits & 0xff00) == 0xff00;
+   }
+#endif
+   for( ; i < count; i++) {
+      macs[i] = (((interfaceIDs[i] >> 16) & UpperMACMask) |
+                 (interfaceIDs[i] & LowerMACMask)) ^ (UniversalLocalBit >> 16);
+      isEUI64[i] = ((interfaceIDs[i] & EUI64MarkerMask) == EUI64Marker);
+   }
+}
+
+
+// ###### Read list of MAC addresses ########################################
+static bool readMACList(const char* fileName, std::vector<uint64_t>& macList)
+{
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(fileName, "-") != 0) {
+      fileStream.open(fileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   std::string  line;
+   unsigned int lineNumber = 0;
+   uint64_t     mac;
+   while(std::getline(*is, line)) {
+      lineNumber++;
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      size_t end = line.find_first_of(" \t\r,#", begin);
+      if(end == std::string::npos) {
+         end = line.size();
+      }
+      if(!parseMACAddress(line.c_str() + begin, end - begin, mac)) {
+         std::cerr << format(gettext("ERROR: Invalid MAC address %s in %s, line %u!"),
+                             line.substr(begin, end - begin).c_str(),
+                             fileName, lineNumber) << "\n";
+         return false;
+      }
+      macList.push_back(mac);
+   }
+   return true;
+}
+
+
+// ###### Print SLAAC addresses for all MAC/prefix combinations #############
+bool printSLAACAddresses(std::ostream&      os,
+                         const OutputFormat outputFormat,
+                         const char*        macListFileName,
+                         const char*        prefixListFileName)
+{
+   std::vector<uint64_t> macList;
+   std::vector<Prefix>   prefixList;
+   if( (!readMACList(macListFileName, macList)) ||
+       (!readPrefixList(prefixListFileName, prefixList)) ) {
+      return false;
+   }
+   for(const Prefix& prefix : prefixList) {
+      if( (prefix.family != AF_INET6) || (prefix.length > 64) ) {
+         std::cerr << format(gettext("ERROR: SLAAC needs IPv6 prefixes of length /64 or shorter, not %s!"),
+                             prefixToString(prefix).c_str()) << "\n";
+         return false;
+      }
+   }
+
+   std::vector<uint64_t> interfaceIDs(macList.size());
+   macsToInterfaceIDs(macList.data(), interfaceIDs.data(), macList.size());
+
+   RecordWriter writer(os, outputFormat, { { "mac",            false },
+                                           { "prefix",         false },
+                                           { "address",        false },
+                                           { "solicited_node", false } });
+   for(const Prefix& prefix : prefixList) {
+      const std::string prefixString = prefixToString(prefix);
+      for(size_t i = 0; i < macList.size(); i++) {
+         const AddressValue address { prefix.network.high, interfaceIDs[i] };
+         writer.write({ macAddressToString(macList[i]),
+                        prefixString,
+                        addressValueToString(AF_INET6, address),
+                        addressValueToString(AF_INET6, solicitedNodeAddress(address)) });
+      }
+   }
+   writer.finish();
+   return true;
+}
+
+
+// ###### Print MAC addresses embedded in IPv6 addresses ####################
+// Addresses without modified EUI-64 interface ID, as well as IPv4
+// addresses, are skipped.
+bool printEmbeddedMACs(std::ostream&      os,
+                       const OutputFormat outputFormat,
+                       const char*        addressListFileName)
+{
+   std::vector<Prefix> addressList;
+   if(!readAddressList(addressListFileName, addressList)) {
+      return false;
+   }
+
+   std::vector<uint64_t> interfaceIDs;
+   interfaceIDs.reserve(addressList.size());
+   for(const Prefix& address : addressList) {
+      interfaceIDs.push_back(address.network.low);
+   }
+   std::vector<uint64_t> macs(interfaceIDs.size());
+   std::vector<uint8_t>  isEUI64(interfaceIDs.size());
+   interfaceIDsToMACs(interfaceIDs.data(), macs.data(), isEUI64.data(), interfaceIDs.size());
+
+   RecordWriter writer(os, outputFormat, { { "address", false },
+                                           { "mac",     false } });
+   for(size_t i = 0; i < addressList.size(); i++) {
+      if( (isEUI64[i]) && (addressList[i].family == AF_INET6) ) {
+         writer.write({ addressValueToString(AF_INET6, addressList[i].network),
+                        macAddressToString(macs[i]) });
+      }
+   }
+   writer.finish();
+   return true;
+}
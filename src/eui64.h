@@ -0,0 +1,62 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef EUI64_H
+#define EUI64_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "output.h"
+
+
+// MAC addresses are stored in the lower 48 bits of a 64-bit value, the
+// first octet being the most significant one.
+bool parseMACAddress(const char* string, const size_t length, uint64_t& mac);
+std::string macAddressToString(const uint64_t mac);
+
+void macsToInterfaceIDs(const uint64_t* macs,
+                        uint64_t*       interfaceIDs,
+                        const size_t    count);
+void interfaceIDsToMACs(const uint64_t* interfaceIDs,
+                        uint64_t*       macs,
+                        uint8_t*        isEUI64,
+                        const size_t    count);
+
+bool printSLAACAddresses(std::ostream&      os,
+                         const OutputFormat outputFormat,
+                         const char*        macListFileName,
+                         const char*        prefixListFileName);
+bool printEmbeddedMACs(std::ostream&      os,
+                       const OutputFormat outputFormat,
+                       const char*        addressListFileName);
+
+#endif
@@ -0,0 +1,257 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "generator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+#include <unordered_set>
+
+#if defined(HAVE_GETRANDOM)
+#include <sys/random.h>
+#endif
+
+
+static const size_t             EntropyPoolSize = 65536;
+// Limit of the hash set of the generated values (about 200 GiB of memory):
+static const unsigned long long MaxUniqueValues = 1ULL << 32;
+
+
+// ###### Parse generation mode #############################################
+bool parseGenerateMode(const char* string, GenerateMode& generateMode)
+{
+   if(strcmp(string, "ula") == 0) {
+      generateMode = GM_UniqueLocal;
+   }
+   else if(strcmp(string, "iid") == 0) {
+      generateMode = GM_InterfaceID;
+   }
+   else if(strcmp(string, "host") == 0) {
+      generateMode = GM_Host;
+   }
+   else {
+      return false;
+   }
+   return true;
+}
+
+
+// ###### Constructor #######################################################
+EntropyPool::EntropyPool(const bool highQualityRng)
+   : HighQualityRng(highQualityRng)
+{
+   Buffer    = new uint8_t[EntropyPoolSize];
+   Available = 0;
+   DeviceFD  = -1;
+}
+
+
+// ###### Destructor ########################################################
+EntropyPool::~EntropyPool()
+{
+   if(DeviceFD >= 0) {
+      close(DeviceFD);
+   }
+   memset(Buffer, 0, EntropyPoolSize);
+   delete [] Buffer;
+}
+
+
+// ###### Refill the buffer #################################################
+// The whole buffer is filled by as few system calls as possible. Consumed
+// bytes are taken from the end of the buffer, so that a refill is only
+// necessary when the buffer is empty.
+bool EntropyPool::refill()
+{
+   size_t filled = 0;
+   while(filled < EntropyPoolSize) {
+      ssize_t result;
+#if defined(HAVE_GETRANDOM)
+      result = getrandom(&Buffer[filled], EntropyPoolSize - filled,
+                         HighQualityRng ? GRND_RANDOM : 0);
+#else
+      const char* randomFile = HighQualityRng ? "/dev/random" : "/dev/urandom";
+      if(DeviceFD < 0) {
+         DeviceFD = open(randomFile, O_RDONLY);
+         if(DeviceFD < 0) {
+            std::cerr << format(gettext("ERROR: Unable to open %s!"), randomFile) << "\n";
+            return false;
+         }
+      }
+      result = read(DeviceFD, &Buffer[filled], EntropyPoolSize - filled);
+#endif
+      if(result < 0) {
+         if(errno == EINTR) {
+            continue;
+         }
+         std::cerr << format(gettext("ERROR: Unable to get random data: %s!"),
+                             strerror(errno)) << "\n";
+         return false;
+      }
+      else if(result == 0) {
+         std::cerr << gettext("ERROR: Unable to get random data!") << "\n";
+         return false;
+      }
+      filled += (size_t)result;
+   }
+   Available = EntropyPoolSize;
+   return true;
+}
+
+
+// ###### Get random bytes ##################################################
+bool EntropyPool::getBytes(void* data, size_t length)
+{
+   uint8_t* output = (uint8_t*)data;
+   while(length > 0) {
+      if( (Available == 0) && (!refill()) ) {
+         return false;
+      }
+      const size_t chunk = std::min(length, Available);
+      Available -= chunk;
+      memcpy(output, &Buffer[Available], chunk);
+      memset(&Buffer[Available], 0, chunk);   // Do not keep used bytes
+      output += chunk;
+      length -= chunk;
+   }
+   return true;
+}
+
+
+// ###### Get random 64-bit number ##########################################
+bool EntropyPool::getUInt64(uint64_t& value)
+{
+   return getBytes(&value, sizeof(value));
+}
+
+
+// ###### Check for reserved interface identifier ###########################
+// Reserved by RFC 5453: the Subnet-Router anycast identifier (zero), the
+// identifiers of the Ethernet block 0200:5eff:fe00:0000-0200:5eff:fe00:5213
+// and the subnet anycast identifiers fdff:ffff:ffff:ff80-fdff:ffff:ffff:ffff.
+static const unsigned long long ReservedInterfaceIDs = 1 + 0x5214 + 128;
+
+static inline bool isReservedInterfaceID(const uint64_t iid)
+{
+   return (iid == 0) ||
+          ( (iid >= 0x02005efffe000000ULL) && (iid <= 0x02005efffe005213ULL) ) ||
+          ( (iid >= 0xfdffffffffffff80ULL) && (iid <= 0xfdffffffffffffffULL) );
+}
+
+
+// ###### Generate unique random prefixes or addresses ######################
+// Candidates are drawn from a buffered entropy pool. A hash set of the
+// values already printed ensures that every output value is unique.
+bool generateAddresses(std::ostream&            os,
+                       const OutputFormat       outputFormat,
+                       const GenerateMode       generateMode,
+                       const Prefix&            parent,
+                       const unsigned long long count,
+                       const bool               highQualityRng)
+{
+   // ====== Check parameters and size of the value space ===================
+   unsigned int       family = AF_INET6;
+   unsigned int       length = 128;
+   unsigned int       randomBits;
+   unsigned long long reserved = 0;
+   if(generateMode == GM_UniqueLocal) {
+      length     = 48;
+      randomBits = 40;
+   }
+   else if(generateMode == GM_InterfaceID) {
+      if( (parent.family != AF_INET6) || (parent.length > 64) ) {
+         std::cerr << gettext("ERROR: An IPv6 prefix of length /64 or shorter must be given to generate interface identifiers!") << "\n";
+         return false;
+      }
+      randomBits = 64;
+      reserved   = ReservedInterfaceIDs;
+   }
+   else {
+      family     = parent.family;
+      length     = familyBits(family);
+      randomBits = length - parent.length;
+      reserved   = reservedHosts(parent);
+   }
+   if( ((randomBits < 64) && (count > (1ULL << randomBits) - reserved)) ||
+       ((randomBits == 64) && (reserved > 0) && (count > 0ULL - reserved)) ) {
+      std::cerr << format(gettext("ERROR: Only %llu unique values are available!"),
+                          ((randomBits < 64) ? (1ULL << randomBits) : 0ULL) - reserved) << "\n";
+      return false;
+   }
+   std::unordered_set<AddressValue, AddressValueHash> used;
+   if(count > std::min((unsigned long long)used.max_size(), MaxUniqueValues)) {
+      std::cerr << format(gettext("ERROR: At most %llu unique values can be generated at once!"),
+                          std::min((unsigned long long)used.max_size(), MaxUniqueValues)) << "\n";
+      return false;
+   }
+
+   // ====== Generate values ================================================
+   EntropyPool pool(highQualityRng);
+   used.reserve((size_t)std::min(count, 1ULL << 20));
+   RecordWriter writer(os, outputFormat,
+                       { { (generateMode == GM_UniqueLocal) ? "prefix" : "address", false } });
+   const AddressValue mask = (generateMode == GM_Host) ?
+                                hostMask(family, parent.length) : AddressValue { 0, 0 };
+   while(used.size() < count) {
+      AddressValue value;
+      if( (!pool.getUInt64(value.high)) || (!pool.getUInt64(value.low)) ) {
+         return false;
+      }
+      if(generateMode == GM_UniqueLocal) {
+         value.high = 0xfd00000000000000ULL | (value.high & 0x00ffffffffff0000ULL);
+         value.low  = 0;
+      }
+      else if(generateMode == GM_InterfaceID) {
+         if(isReservedInterfaceID(value.low)) {
+            continue;
+         }
+         value.high = parent.network.high;
+      }
+      else {
+         value = parent.network | (value & mask);
+         if(isReservedHost(parent, value)) {
+            continue;
+         }
+      }
+      if(!used.insert(value).second) {
+         continue;
+      }
+      writer.write({ (generateMode == GM_UniqueLocal) ?
+                        prefixToString(Prefix { value, (uint8_t)family, (uint8_t)length, 0 }) :
+                        addressValueToString(family, value) });
+   }
+   writer.finish();
+   return true;
+}
@@ -0,0 +1,77 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "output.h"
+#include "prefixlist.h"
+
+
+enum GenerateMode {
+   GM_UniqueLocal = 0,   // Unique local /48 prefixes (RFC 4193)
+   GM_InterfaceID = 1,   // Random interface identifiers in a /64
+   GM_Host        = 2    // Random hosts in a prefix
+};
+
+bool parseGenerateMode(const char* string, GenerateMode& generateMode);
+
+
+// ###### Buffered source of random bytes ###################################
+class EntropyPool
+{
+   public:
+   EntropyPool(const bool highQualityRng = false);
+   ~EntropyPool();
+
+   bool getBytes(void* data, size_t length);
+   bool getUInt64(uint64_t& value);
+
+   private:
+   bool refill();
+
+   const bool HighQualityRng;
+   uint8_t*   Buffer;
+   size_t     Available;
+   int        DeviceFD;
+};
+
+
+bool generateAddresses(std::ostream&            os,
+                       const OutputFormat       outputFormat,
+                       const GenerateMode       generateMode,
+                       const Prefix&            parent,
+                       const unsigned long long count,
+                       const bool               highQualityRng);
+
+#endif
@@ -0,0 +1,370 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "geoip.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+// After <filesystem>, since it includes <libintl.h>:
+#include "prefixlist.h"
+
+
+#ifdef HAVE_MAXMINDDB
+// ###### Find location of MaxMindDB .mmdb file #############################
+std::string find_mmdb_path(const std::string& mmdbFileName) {
+   static const std::vector<std::string> mmdbDirectories = {
+      "/usr/share/GeoIP",          // Debian, Ubuntu
+      "/var/lib/GeoIP",            // CentOS, Fedora, RedHat
+      "/usr/local/share/GeoIP",    // FreeBSD
+      "/opt/homebrew/var/GeoIP",   // MacOS (Homebrew Apple Silicon)
+      "/usr/local/var/GeoIP",      // MacOS (Homebrew Intel)
+      "/etc/GeoIP"                 // Legacy
+   };
+
+   for (const auto& directory : mmdbDirectories) {
+      const std::filesystem::path absolutePath =
+         std::filesystem::path(directory) / mmdbFileName;
+      if(std::filesystem::exists(absolutePath)) {
+         return absolutePath.string();
+      }
+    }
+    return "";
+}
+
+
+// ###### Open MaxMindDB database (only once) ###############################
+// The database stays open (memory-mapped) until the program terminates,
+// so that subsequent lookups do not need to search and map it again.
+MMDB_s* openGeoIPDatabase(const char* mmdbFileName)
+{
+   static std::map<std::string, MMDB_s*> databases;
+   const auto found = databases.find(mmdbFileName);
+   if(found != databases.end()) {
+      return found->second;
+   }
+
+   MMDB_s*           mmdb = nullptr;
+   const std::string path = find_mmdb_path(mmdbFileName);
+   if(!path.empty()) {
+      mmdb = new MMDB_s;
+      if(MMDB_open(path.c_str(), MMDB_MODE_MMAP, mmdb) != MMDB_SUCCESS) {
+         delete mmdb;
+         mmdb = nullptr;
+      }
+   }
+   databases.insert(std::make_pair(std::string(mmdbFileName), mmdb));
+   return mmdb;
+}
+
+
+// ###### Aggregation group (one ASN or one country) ########################
+struct GeoIPGroup {
+   std::string        Key;
+   std::string        Name;
+   unsigned long long Addresses = 0;
+   unsigned long long Networks  = 0;   // Distinct /24 (IPv4) or /48 (IPv6)
+};
+
+
+// ###### Table of aggregation groups #######################################
+struct GeoIPTable {
+   const char*                              Name;
+   std::vector<GeoIPGroup>                  Groups;
+   std::unordered_map<std::string, int32_t> GroupByKey;
+   std::unordered_map<uint32_t, int32_t>    GroupByRecord;   // By data offset
+   std::set<std::pair<uint64_t, int32_t>>   SplitNetworks;
+
+   GeoIPTable(const char* name) : Name(name) { }
+
+   // Get group of a key (created if necessary):
+   int32_t group(const std::string& key, const std::string& name) {
+      const auto found = GroupByKey.find(key);
+      if(found != GroupByKey.end()) {
+         return found->second;
+      }
+      const int32_t index = (int32_t)Groups.size();
+      Groups.push_back(GeoIPGroup { key, name });
+      GroupByKey.insert(std::make_pair(key, index));
+      return index;
+   }
+};
+
+
+// ###### Groups of a /24 (IPv4) or /48 (IPv6) network ######################
+struct GeoIPNetworkGroups {
+   int32_t ASNGroup;
+   int32_t CountryGroup;
+   bool    Split;   // Database networks are more specific than the network
+};
+
+
+// ###### Get string value of a database entry ##############################
+static std::string getStringValue(MMDB_entry_s entry, const char* name1,
+                                  const char* name2 = nullptr,
+                                  const char* name3 = nullptr)
+{
+   MMDB_entry_data_s data;
+   if( (MMDB_get_value(&entry, &data, name1, name2, name3, nullptr) == MMDB_SUCCESS) &&
+       (data.has_data) ) {
+      return std::string(data.utf8_string, data.data_size);
+   }
+   return std::string();
+}
+
+
+// ###### Look up address in database #######################################
+// Returns the prefix length of the database network containing the address.
+static unsigned int lookupAddress(MMDB_s*               mmdb,
+                                  const unsigned int    family,
+                                  const sockaddr_union& address,
+                                  MMDB_lookup_result_s& result)
+{
+   int mmdbErrorCode;
+   result = MMDB_lookup_sockaddr(mmdb, &address.sa, &mmdbErrorCode);
+   if(mmdbErrorCode != MMDB_SUCCESS) {
+      result.found_entry = false;
+      return familyBits(family);
+   }
+   // IPv4 addresses are looked up as ::a.b.c.d in an IPv6 database:
+   unsigned int length = result.netmask;
+   if( (family == AF_INET) && (mmdb->metadata.ip_version == 6) ) {
+      length = (length > 96) ? (length - 96) : 0;
+   }
+   return length;
+}
+
+
+// ###### Get ASN group of a lookup result ##################################
+// Each database record is decoded only once.
+static int32_t asnGroup(GeoIPTable& table, const MMDB_lookup_result_s& result)
+{
+   if(!result.found_entry) {
+      return table.group("unknown", "");
+   }
+   const auto found = table.GroupByRecord.find(result.entry.offset);
+   if(found != table.GroupByRecord.end()) {
+      return found->second;
+   }
+   MMDB_entry_s      entry = result.entry;
+   MMDB_entry_data_s data;
+   std::string       key   = "unknown";
+   if( (MMDB_get_value(&entry, &data, "autonomous_system_number", nullptr) == MMDB_SUCCESS) &&
+       (data.has_data) ) {
+      key = "AS" + std::to_string(data.uint32);
+   }
+   const int32_t group = table.group(key, getStringValue(entry, "autonomous_system_organization"));
+   table.GroupByRecord.insert(std::make_pair(result.entry.offset, group));
+   return group;
+}
+
+
+// ###### Get country group of a lookup result ##############################
+// Each database record is decoded only once.
+static int32_t countryGroup(GeoIPTable& table, const MMDB_lookup_result_s& result)
+{
+   if(!result.found_entry) {
+      return table.group("unknown", "");
+   }
+   const auto found = table.GroupByRecord.find(result.entry.offset);
+   if(found != table.GroupByRecord.end()) {
+      return found->second;
+   }
+   std::string key = getStringValue(result.entry, "country", "iso_code");
+   if(key.empty()) {
+      key = "unknown";
+   }
+   const int32_t group = table.group(key, getStringValue(result.entry, "country", "names", "en"));
+   table.GroupByRecord.insert(std::make_pair(result.entry.offset, group));
+   return group;
+}
+
+
+// ###### Print top groups of a table #######################################
+static void printTopGroups(RecordWriter&      writer,
+                           const GeoIPTable&  table,
+                           const unsigned long long top)
+{
+   std::vector<const GeoIPGroup*> groups;
+   groups.reserve(table.Groups.size());
+   for(const GeoIPGroup& group : table.Groups) {
+      groups.push_back(&group);
+   }
+   const size_t n = ((top == 0) || (top > groups.size())) ? groups.size() : top;
+   std::partial_sort(groups.begin(), groups.begin() + n, groups.end(),
+                     [](const GeoIPGroup* g1, const GeoIPGroup* g2) {
+                        if(g1->Addresses != g2->Addresses) {
+                           return g1->Addresses > g2->Addresses;
+                        }
+                        if(g1->Networks != g2->Networks) {
+                           return g1->Networks > g2->Networks;
+                        }
+                        return g1->Key < g2->Key;
+                     });
+   for(size_t i = 0; i < n; i++) {
+      writer.write({ table.Name, std::to_string(i + 1),
+                     groups[i]->Key, groups[i]->Name,
+                     std::to_string(groups[i]->Addresses),
+                     std::to_string(groups[i]->Networks) });
+   }
+}
+#endif
+
+
+// ###### Print address counts per ASN and per country ######################
+// The addresses are streamed, i.e. they are not stored. The database
+// lookup results are cached per /24 (IPv4) or /48 (IPv6) network, if the
+// database networks of both the ASN and the city database cover it. Then,
+// each such network is looked up only once, and each database record is
+// decoded only once. Addresses in more specific database networks are
+// looked up individually.
+bool printGeoIPStatistics(std::ostream&            os,
+                          const OutputFormat       outputFormat,
+                          const char*              addressListFileName,
+                          const unsigned long long top)
+{
+#ifdef HAVE_MAXMINDDB
+   MMDB_s* asnDatabase  = openGeoIPDatabase("GeoLite2-ASN.mmdb");
+   MMDB_s* cityDatabase = openGeoIPDatabase("GeoLite2-City.mmdb");
+   if( (asnDatabase == nullptr) || (cityDatabase == nullptr) ) {
+      std::cerr << format(gettext("ERROR: Unable to open GeoIP databases %s and %s!"),
+                          "GeoLite2-ASN.mmdb", "GeoLite2-City.mmdb") << "\n";
+      return false;
+   }
+
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(addressListFileName, "-") != 0) {
+      fileStream.open(addressListFileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), addressListFileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   // ====== Aggregate addresses ============================================
+   GeoIPTable                                       asnTable     { "asn" };
+   GeoIPTable                                       countryTable { "country" };
+   std::unordered_map<uint64_t, GeoIPNetworkGroups> networkCache;
+   std::string                                      line;
+   unsigned int                                     lineNumber = 0;
+   AddressValue                                     value;
+   unsigned int                                     family;
+   unsigned int                                     length;
+   sockaddr_union                                   address;
+   MMDB_lookup_result_s                             asnResult;
+   MMDB_lookup_result_s                             cityResult;
+   while(std::getline(*is, line)) {
+      lineNumber++;
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      const size_t end = line.find_first_of(" \t\r,#", begin);
+      if(end != std::string::npos) {
+         line.resize(end);
+      }
+      if( (!parseAddressPrefix(line.c_str() + begin, value, family, length)) ||
+          (length != familyBits(family)) ) {
+         std::cerr << format(gettext("ERROR: Invalid address %s in %s, line %u!"),
+                             line.c_str() + begin, addressListFileName, lineNumber) << "\n";
+         return false;
+      }
+
+      // ------ Look up the /24 or /48 network, once -----------------------
+      const unsigned int networkLength = (family == AF_INET) ? 24 : 48;
+      const uint64_t     networkKey    = (family == AF_INET) ?
+                                            ((1ULL << 63) | (value.low >> 8)) :
+                                            (value.high >> 16);
+      auto found = networkCache.find(networkKey);
+      if(found == networkCache.end()) {
+         valueToAddress(family, value, address);
+         const unsigned int asnLength  = lookupAddress(asnDatabase, family, address, asnResult);
+         const unsigned int cityLength = lookupAddress(cityDatabase, family, address, cityResult);
+         GeoIPNetworkGroups groups;
+         groups.ASNGroup     = asnGroup(asnTable, asnResult);
+         groups.CountryGroup = countryGroup(countryTable, cityResult);
+         groups.Split        = (asnLength > networkLength) || (cityLength > networkLength);
+         if(!groups.Split) {
+            asnTable.Groups[groups.ASNGroup].Networks++;
+            countryTable.Groups[groups.CountryGroup].Networks++;
+         }
+         found = networkCache.insert(std::make_pair(networkKey, groups)).first;
+      }
+      if(!found->second.Split) {
+         asnTable.Groups[found->second.ASNGroup].Addresses++;
+         countryTable.Groups[found->second.CountryGroup].Addresses++;
+         continue;
+      }
+
+      // ------ More specific database networks: look up the address -------
+      valueToAddress(family, value, address);
+      lookupAddress(asnDatabase, family, address, asnResult);
+      lookupAddress(cityDatabase, family, address, cityResult);
+      const int32_t asn     = asnGroup(asnTable, asnResult);
+      const int32_t country = countryGroup(countryTable, cityResult);
+      asnTable.Groups[asn].Addresses++;
+      countryTable.Groups[country].Addresses++;
+      if(asnTable.SplitNetworks.insert(std::make_pair(networkKey, asn)).second) {
+         asnTable.Groups[asn].Networks++;
+      }
+      if(countryTable.SplitNetworks.insert(std::make_pair(networkKey, country)).second) {
+         countryTable.Groups[country].Networks++;
+      }
+   }
+
+   // ====== Print top groups ===============================================
+   RecordWriter writer(os, outputFormat, { { "table",     false },
+                                           { "rank",      true  },
+                                           { "key",       false },
+                                           { "name",      false },
+                                           { "addresses", true  },
+                                           { "networks",  true  } });
+   printTopGroups(writer, asnTable, top);
+   printTopGroups(writer, countryTable, top);
+   return true;
+#else
+   (void)os;
+   (void)outputFormat;
+   (void)addressListFileName;
+   (void)top;
+   std::cerr << gettext("ERROR: GeoIP support is not available!") << "\n";
+   return false;
+#endif
+}
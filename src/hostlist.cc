@@ -0,0 +1,250 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "hostlist.h"
+
+#include <cstring>
+#include <iostream>
+
+
+// ###### Buffered output of address records ################################
+// Records are formatted like by RecordWriter with the single field
+// "address", but written into a large buffer instead of the stream.
+class HostWriter
+{
+   public:
+   HostWriter(std::ostream& os, const OutputFormat outputFormat);
+   ~HostWriter();
+
+   // Returns the position to write an address of up to MaxAddressLength
+   // characters to.
+   inline char* begin() {
+      if(Position + MaxRecordLength > Buffer + sizeof(Buffer)) {
+         flush();
+      }
+      memcpy(Position, Separator, SeparatorLength);
+      return Position + SeparatorLength;
+   }
+   // Completes the record, whose address ends at the given position.
+   inline void end(char* addressEnd) {
+      memcpy(addressEnd, Suffix, SuffixLength);
+      Position = addressEnd + SuffixLength;
+      if(Format == OF_JSON) {
+         Separator       = ",\n { \"address\": \"";
+         SeparatorLength = strlen(Separator);
+      }
+   }
+
+   bool finish();
+
+   static const size_t MaxAddressLength = 64;
+
+   private:
+   static const size_t MaxRecordLength = MaxAddressLength + 32;
+
+   void flush();
+
+   std::ostream&      OS;
+   const OutputFormat Format;
+   const char*        Separator;
+   size_t             SeparatorLength;
+   const char*        Suffix;
+   size_t             SuffixLength;
+   char*              Position;
+   char               Buffer[1 << 20];
+};
+
+
+// ###### Constructor #######################################################
+HostWriter::HostWriter(std::ostream& os, const OutputFormat outputFormat)
+   : OS(os),
+     Format(outputFormat)
+{
+   Position = Buffer;
+   if(Format == OF_JSON) {
+      OS << "[";
+      Separator = "\n { \"address\": \"";
+      Suffix    = "\" }";
+   }
+   else {
+      if(Format == OF_CSV) {
+         OS << "address\n";
+      }
+      Separator = "";
+      Suffix    = "\n";
+   }
+   SeparatorLength = strlen(Separator);
+   SuffixLength    = strlen(Suffix);
+}
+
+
+// ###### Destructor ########################################################
+HostWriter::~HostWriter()
+{
+   flush();
+}
+
+
+// ###### Write buffer to the stream ########################################
+void HostWriter::flush()
+{
+   OS.write(Buffer, Position - Buffer);
+   Position = Buffer;
+}
+
+
+// ###### Finish output #####################################################
+bool HostWriter::finish()
+{
+   flush();
+   if(Format == OF_JSON) {
+      OS << ((Separator[0] == ',') ? "\n]\n" : "]\n");
+   }
+   OS.flush();
+   return OS.good();
+}
+
+
+// ###### Decimal strings of all octet values ###############################
+struct OctetTable {
+   char    Text[256][4];
+   uint8_t Length[256];
+
+   OctetTable() {
+      for(unsigned int i = 0; i < 256; i++) {
+         Length[i] = (uint8_t)snprintf(Text[i], sizeof(Text[i]), "%u", i);
+      }
+   }
+};
+
+
+// ###### Write 16-bit group in hexadecimal without leading zeros ###########
+static inline char* writeHexGroup(char* str, const unsigned int value)
+{
+   static const char hexDigits[] = "0123456789abcdef";
+   const unsigned int digits = (value >= 0x1000) ? 4 : (value >= 0x100) ? 3 : (value >= 0x10) ? 2 : 1;
+   for(unsigned int i = digits; i > 0; i--) {
+      str[i - 1] = hexDigits[(value >> (4 * (digits - i))) & 0xf];
+   }
+   return str + digits;
+}
+
+
+// ###### Format address with address2string() #############################
+static inline char* writeAddress(char*               str,
+                                 const unsigned int  family,
+                                 const AddressValue& value)
+{
+   sockaddr_union address;
+   valueToAddress(family, value, address);
+   address2string(&address.sa, str, HostWriter::MaxAddressLength, false, true);
+   return str + strlen(str);
+}
+
+
+// ###### Print all hosts of a prefix #######################################
+// The hosts are the ones of the host range, i.e. the reserved hosts are
+// skipped (see reservedHosts()). The addresses are enumerated in blocks
+// of 256 (IPv4) or 65536 (IPv6) addresses, differing only in the last
+// octet or group. The text of the remaining address is formatted once per
+// block, and then only the text of the last octet or group is appended.
+bool listHosts(std::ostream&      os,
+               const OutputFormat outputFormat,
+               const Prefix&      parent)
+{
+   // ====== Get host range =================================================
+   AddressValue first = parent.network;
+   AddressValue last  = lastAddress(parent);
+   if(reservedHosts(parent) > 0) {
+      first = increment(first);
+      if(parent.family == AF_INET) {
+         last = decrement(last);
+      }
+   }
+
+   HostWriter     writer(os, outputFormat);
+   AddressValue   current = first;
+   const uint64_t mask    = (parent.family == AF_INET) ? 0xff : 0xffff;
+   char           blockPrefix[HostWriter::MaxAddressLength];
+   size_t         blockPrefixLength;
+   for(;;) {
+      AddressValue blockLast { current.high, current.low | mask };
+      if(last < blockLast) {
+         blockLast = last;
+      }
+      const unsigned int from = (unsigned int)(current.low & mask);
+      const unsigned int to   = (unsigned int)(blockLast.low & mask);
+
+      // ====== IPv4: a.b.c. followed by the last octet =====================
+      if(parent.family == AF_INET) {
+         static const OctetTable octets;
+         blockPrefixLength = writeAddress(blockPrefix, AF_INET, AddressValue { 0, current.low & ~mask }) -
+                                blockPrefix - 1;   // Without "0"
+         for(unsigned int v = from; v <= to; v++) {
+            char* str = writer.begin();
+            memcpy(str, blockPrefix, blockPrefixLength);
+            memcpy(str + blockPrefixLength, octets.Text[v], 4);
+            writer.end(str + blockPrefixLength + octets.Length[v]);
+         }
+      }
+
+      // ====== IPv6: groups 0 to 6, followed by the last group =============
+      // The text of the first 7 groups only depends on whether the last
+      // group is 0, which is therefore formatted separately. Blocks
+      // written with a dotted-decimal suffix (e.g. IPv4-mapped addresses)
+      // are formatted completely.
+      else {
+         const AddressValue probe { current.high, (current.low & ~mask) | 1 };
+         blockPrefixLength = writeAddress(blockPrefix, AF_INET6, probe) - blockPrefix;
+         const bool hexSuffix = (blockPrefixLength >= 2) &&
+                                (blockPrefix[blockPrefixLength - 2] == ':') &&
+                                (blockPrefix[blockPrefixLength - 1] == '1');
+         blockPrefixLength--;   // Without "1"
+         for(unsigned int v = from; v <= to; v++) {
+            char* str = writer.begin();
+            if( (v > 0) && (hexSuffix) ) {
+               memcpy(str, blockPrefix, blockPrefixLength);
+               writer.end(writeHexGroup(str + blockPrefixLength, v));
+            }
+            else {
+               writer.end(writeAddress(str, AF_INET6,
+                                       AddressValue { current.high, (current.low & ~mask) | v }));
+            }
+         }
+      }
+
+      if( (blockLast == last) || (!os.good()) ) {
+         break;
+      }
+      current = increment(blockLast);
+   }
+   return writer.finish();
+}
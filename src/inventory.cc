@@ -0,0 +1,621 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "inventory.h"
+#include "statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sys/stat.h>
+
+
+// ###### Sweep collecting the free blocks of a parent prefix ###############
+// The used prefixes have to be given in sort order. Each unallocated range
+// within the parent prefix is split into its maximal CIDR blocks, which are
+// appended to the free list.
+class FreeSpaceSweep
+{
+   public:
+   FreeSpaceSweep(const Prefix& parent, std::vector<Prefix>& freeList)
+      : Parent(parent),
+        ParentLast(lastAddress(parent)),
+        FreeList(freeList) {
+      Cursor    = parent.network;
+      Exhausted = false;
+   }
+
+   // Returns false when the whole parent prefix is covered.
+   bool add(const Prefix& used) {
+      if( (Exhausted) || (used.family != Parent.family) ) {
+         return !Exhausted;
+      }
+      const AddressValue usedLast = lastAddress(used);
+      if( (usedLast < Cursor) || (ParentLast < used.network) ) {
+         return true;   // Outside of parent, or already covered
+      }
+      if(Cursor < used.network) {
+         rangeToPrefixes(Parent.family, Cursor, decrement(used.network), FreeList);
+      }
+      if(!(usedLast < ParentLast)) {
+         Exhausted = true;
+         return false;
+      }
+      Cursor = increment(usedLast);
+      return true;
+   }
+
+   void finish() {
+      if(!Exhausted) {
+         rangeToPrefixes(Parent.family, Cursor, ParentLast, FreeList);
+         Exhausted = true;
+      }
+   }
+
+   private:
+   const Prefix&        Parent;
+   const AddressValue   ParentLast;
+   std::vector<Prefix>& FreeList;
+   AddressValue         Cursor;
+   bool                 Exhausted;
+};
+
+
+// ###### Print free blocks of a parent prefix ##############################
+// The used prefixes are sorted, then a single sweep over them collects the
+// unallocated ranges within the parent prefix. Each range is split into its
+// maximal CIDR blocks. Only blocks with prefix length <= maxLength are printed.
+bool printFreeSpace(std::ostream&      os,
+                    const OutputFormat outputFormat,
+                    const Prefix&      parent,
+                    const char*        usedListFileName,
+                    const unsigned int maxLength)
+{
+   std::vector<Prefix> usedList;
+   if(!readPrefixList(usedListFileName, usedList)) {
+      return false;
+   }
+   sortPrefixList(usedList);
+
+   // ====== Sweep over used prefixes =======================================
+   std::vector<Prefix> freeList;
+   FreeSpaceSweep      sweep(parent, freeList);
+   for(const Prefix& used : usedList) {
+      if(!sweep.add(used)) {
+         break;
+      }
+   }
+   sweep.finish();
+
+   // ====== Print free blocks ==============================================
+   RecordWriter writer(os, outputFormat, { { "prefix",        false },
+                                           { "prefix_length", true  } });
+   for(const Prefix& block : freeList) {
+      if(block.length <= maxLength) {
+         writer.write({ prefixToString(block), std::to_string(block.length) });
+      }
+   }
+   return true;
+}
+
+
+// ###### Print overlapping prefixes of one or more prefix lists ############
+// For CIDR prefixes, two prefixes overlap if and only if they are identical
+// or one contains the other. After sorting, a stack holds the chain of
+// prefixes containing the current one: all of them overlap the current one.
+// Therefore, the runtime is O(n log n + k) for k reported pairs.
+bool printOverlaps(std::ostream&      os,
+                   const OutputFormat outputFormat,
+                   const int          listFiles,
+                   char**             listFileNames)
+{
+   // ====== Read prefix lists ==============================================
+   // A list may be given as "label=file"; otherwise, the file name is used
+   // as label.
+   std::vector<std::string> labels;
+   std::vector<Prefix>      prefixList;
+   for(int i = 0; i < listFiles; i++) {
+      labels.push_back(std::string());
+      const char* fileName = parseListArgument(listFileNames[i], labels.back());
+      if(!readPrefixList(fileName, prefixList, i)) {
+         return false;
+      }
+   }
+   sortPrefixList(prefixList);
+
+   // ====== Sweep over sorted prefixes =====================================
+   RecordWriter writer(os, outputFormat, { { "relation", false },
+                                           { "prefix1",  false },
+                                           { "source1",  false },
+                                           { "prefix2",  false },
+                                           { "source2",  false } });
+   std::vector<const Prefix*> stack;
+   for(const Prefix& prefix : prefixList) {
+      while( (!stack.empty()) &&
+             ( (stack.back()->family != prefix.family) ||
+               (lastAddress(*stack.back()) < prefix.network) ) ) {
+         stack.pop_back();
+      }
+      if(!stack.empty()) {
+         const std::string prefixString = prefixToString(prefix);
+         for(const Prefix* outer : stack) {
+            writer.write({ (*outer == prefix) ? "duplicate" : "contains",
+                           prefixToString(*outer), labels[outer->source],
+                           prefixString,           labels[prefix.source] });
+         }
+      }
+      stack.push_back(&prefix);
+   }
+   return true;
+}
+
+
+// ###### Sorted and deduplicated prefix list ###############################
+// A regular file already given in sort order is streamed: each cursor
+// reads it separately and only holds its current prefix. Otherwise (e.g.
+// for standard input), the list is read, sorted and deduplicated in memory.
+struct SortedPrefixList {
+   const char*         FileName;
+   bool                Streamed;
+   std::vector<Prefix> List;
+};
+
+
+// ###### Read, sort and deduplicate prefix list ############################
+static bool openSortedPrefixList(const char* fileName, SortedPrefixList& list)
+{
+   list.FileName = fileName;
+   list.Streamed = false;
+   list.List.clear();
+
+   // ====== Check whether the file is sorted ===============================
+   // Only regular files can be read more than once.
+   struct stat status;
+   if( (strcmp(fileName, "-") != 0) &&
+       (stat(fileName, &status) == 0) && (S_ISREG(status.st_mode)) ) {
+      PrefixListReader reader(fileName);
+      Prefix           previous;
+      Prefix           prefix;
+      bool             first = true;
+      list.Streamed = true;
+      while(reader.next(prefix)) {
+         if( (!first) && (prefix < previous) ) {
+            list.Streamed = false;
+            break;
+         }
+         previous = prefix;
+         first    = false;
+      }
+      if(reader.failed()) {
+         return false;
+      }
+   }
+
+   // ====== Otherwise, sort the list in memory =============================
+   if(!list.Streamed) {
+      if(!readPrefixList(fileName, list.List)) {
+         return false;
+      }
+      sortPrefixList(list.List);
+      list.List.erase(std::unique(list.List.begin(), list.List.end()),
+                      list.List.end());
+      list.List.shrink_to_fit();
+   }
+   return true;
+}
+
+
+// ###### Forward cursor on a sorted prefix list ############################
+class PrefixCursor
+{
+   public:
+   PrefixCursor(const SortedPrefixList& list)
+      : List(list), Index(0), AtEnd(false) {
+      if(list.Streamed) {
+         Reader.reset(new PrefixListReader(list.FileName));
+      }
+   }
+
+   inline bool atEnd() const { return AtEnd; }
+   inline const Prefix& head() const { return Head; }
+
+   // Moves to the next prefix. Returns false on error.
+   bool advance() {
+      if(Reader) {
+         Prefix prefix;
+         while(Reader->next(prefix)) {
+            if( (Index == 0) || (Head < prefix) ) {
+               Head = prefix;
+               Index++;
+               return true;
+            }
+            if(prefix < Head) {
+               std::cerr << format(gettext("ERROR: Prefix list %s has changed while reading it!"),
+                                   List.FileName) << "\n";
+               return false;
+            }
+         }
+         AtEnd = true;
+         return !Reader->failed();
+      }
+      if(Index < List.List.size()) {
+         Head = List.List[Index++];
+      }
+      else {
+         AtEnd = true;
+      }
+      return true;
+   }
+
+   private:
+   const SortedPrefixList&           List;
+   std::unique_ptr<PrefixListReader> Reader;
+   size_t                            Index;
+   Prefix                            Head;
+   bool                              AtEnd;
+};
+
+
+// ###### Find first changed prefix not before a given prefix ###############
+// "ahead" is a cursor on one list, "twin" a cursor on the other list. A
+// prefix is changed if it is not in the other list. Since the given prefix
+// never decreases between calls, both cursors only move forward.
+static bool findFirstChanged(PrefixCursor&  ahead,
+                             PrefixCursor&  twin,
+                             const Prefix&  from,
+                             const Prefix*& changed)
+{
+   changed = nullptr;
+   while(!ahead.atEnd()) {
+      if(ahead.head() < from) {
+         if(!ahead.advance()) {
+            return false;
+         }
+         continue;
+      }
+      while( (!twin.atEnd()) && (twin.head() < ahead.head()) ) {
+         if(!twin.advance()) {
+            return false;
+         }
+      }
+      if( (!twin.atEnd()) && (twin.head() == ahead.head()) ) {
+         if(!ahead.advance()) {   // Unchanged prefix
+            return false;
+         }
+         continue;
+      }
+      changed = &ahead.head();
+      break;
+   }
+   return true;
+}
+
+
+// ###### Print differences between two prefix lists ########################
+// Both lists are normalised, sorted and deduplicated, and the prefixes in
+// both lists are skipped. Then, a single merge pass classifies the rest:
+// - removed: old prefix without overlap with any new prefix,
+// - added:   new prefix without overlap with any old prefix,
+// - split:   new prefix within an old prefix (old -> more-specifics),
+// - merged:  old prefix within a new prefix (more-specifics -> new).
+// In sort order, a prefix comes directly before the prefixes it contains.
+// So, a stack per list holds the chain of prefixes containing the current
+// one, and the next changed prefix of the other list (found by a second
+// pair of cursors) tells whether the current prefix contains any prefix of
+// it. Files already in sort order are streamed, so that the memory usage
+// does not depend on the list sizes.
+bool printPrefixDiff(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const char*        oldListFileName,
+                     const char*        newListFileName)
+{
+   // ====== Open prefix lists ==============================================
+   SortedPrefixList oldList;
+   SortedPrefixList newList;
+   if( (!openSortedPrefixList(oldListFileName, oldList)) ||
+       (!openSortedPrefixList(newListFileName, newList)) ) {
+      return false;
+   }
+   PrefixCursor oldCursor(oldList);
+   PrefixCursor newCursor(newList);
+   PrefixCursor oldAhead(oldList);       // Next changed old prefix
+   PrefixCursor oldAheadTwin(newList);
+   PrefixCursor newAhead(newList);       // Next changed new prefix
+   PrefixCursor newAheadTwin(oldList);
+   if( (!oldCursor.advance()) || (!newCursor.advance()) ||
+       (!oldAhead.advance())  || (!oldAheadTwin.advance()) ||
+       (!newAhead.advance())  || (!newAheadTwin.advance()) ) {
+      return false;
+   }
+
+   // ====== Merge pass =====================================================
+   RecordWriter writer(os, outputFormat, { { "change",     false },
+                                           { "old_prefix", false },
+                                           { "new_prefix", false } });
+   std::vector<Prefix> oldStack;
+   std::vector<Prefix> newStack;
+   for(;;) {
+      // ------ Skip prefixes contained in both lists -----------------------
+      // Unchanged prefixes are neither reported nor used as container, i.e.
+      // a more-specific of an unchanged prefix is simply added or removed.
+      while( (!oldCursor.atEnd()) && (!newCursor.atEnd()) &&
+             (oldCursor.head() == newCursor.head()) ) {
+         if( (!oldCursor.advance()) || (!newCursor.advance()) ) {
+            return false;
+         }
+      }
+      if( (oldCursor.atEnd()) && (newCursor.atEnd()) ) {
+         break;
+      }
+
+      // ------ Take the next prefix in sort order --------------------------
+      const bool   takeOld = (newCursor.atEnd()) ||
+                             ((!oldCursor.atEnd()) && (oldCursor.head() < newCursor.head()));
+      const Prefix prefix  = (takeOld) ? oldCursor.head() : newCursor.head();
+      while( (!oldStack.empty()) && (!containsPrefix(oldStack.back(), prefix)) ) {
+         oldStack.pop_back();
+      }
+      while( (!newStack.empty()) && (!containsPrefix(newStack.back(), prefix)) ) {
+         newStack.pop_back();
+      }
+
+      // ------ Old prefix --------------------------------------------------
+      const Prefix* next;
+      if(takeOld) {
+         if(!newStack.empty()) {
+            writer.write({ "merged", prefixToString(prefix),
+                           prefixToString(newStack.back()) });
+         }
+         else {
+            if(!findFirstChanged(newAhead, newAheadTwin, prefix, next)) {
+               return false;
+            }
+            if( (next == nullptr) || (!containsPrefix(prefix, *next)) ) {
+               writer.write({ "removed", prefixToString(prefix), "" });
+            }
+            // Otherwise, the contained new prefixes report the split.
+         }
+         oldStack.push_back(prefix);
+         if(!oldCursor.advance()) {
+            return false;
+         }
+      }
+
+      // ------ New prefix --------------------------------------------------
+      else {
+         if(!oldStack.empty()) {
+            writer.write({ "split", prefixToString(oldStack.back()),
+                           prefixToString(prefix) });
+         }
+         else {
+            if(!findFirstChanged(oldAhead, oldAheadTwin, prefix, next)) {
+               return false;
+            }
+            if( (next == nullptr) || (!containsPrefix(prefix, *next)) ) {
+               writer.write({ "added", "", prefixToString(prefix) });
+            }
+            // Otherwise, the contained old prefixes report the merge.
+         }
+         newStack.push_back(prefix);
+         if(!newCursor.advance()) {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+
+// ###### Node of a prefix containment tree #################################
+struct TreeNode {
+   const Prefix*       Block;
+   std::vector<size_t> Children;   // Direct subnets, in sort order
+   WideCounter         Used;       // Addresses covered by the direct subnets
+};
+
+
+// ###### Containment tree and its output settings ##########################
+struct PrefixTree {
+   std::ostream&         OS;
+   const OutputFormat    Format;
+   RecordWriter*         Writer;   // Only for CSV output
+   std::vector<TreeNode> Nodes;
+   std::vector<size_t>   Roots;
+};
+
+
+// ###### Print free block of a tree node ###################################
+static void printTreeFreeBlock(PrefixTree&        tree,
+                               const Prefix&      block,
+                               const unsigned int depth,
+                               const std::string& parentString)
+{
+   const std::string blockString = prefixToString(block);
+   if(tree.Format == OF_Text) {
+      tree.OS << std::string(3 * depth, ' ') << blockString << "  free\n";
+   }
+   else {
+      WideCounter addresses;
+      addresses.addPowerOfTwo(familyBits(block.family) - block.length);
+      tree.Writer->write({ std::to_string(depth), "free", blockString,
+                           parentString, addresses.toString(), "0", "" });
+   }
+}
+
+
+// ###### Print tree node with its subtree ##################################
+// In text and CSV output, the free blocks are interleaved with the subnets
+// in address order. In JSON output, each node has a "free" list of its free
+// blocks and a "children" list of its subnets. A leaf is an allocation, so
+// it has no free blocks.
+static void printTreeNode(PrefixTree&        tree,
+                          const size_t       index,
+                          const unsigned int depth,
+                          const std::string& parentString)
+{
+   const TreeNode&    node        = tree.Nodes[index];
+   const Prefix&      block       = *node.Block;
+   const unsigned int hostBits    = familyBits(block.family) - block.length;
+   const std::string  blockString = prefixToString(block);
+   const std::string  used        = node.Used.toString();
+   WideCounter        addresses;
+   addresses.addPowerOfTwo(hostBits);
+   const double       utilisation = 100.0 * ldexp(node.Used.toDouble(), -(int)hostBits);
+
+   std::vector<Prefix> freeList;
+   FreeSpaceSweep      sweep(block, freeList);
+
+   // ====== JSON: free list first, then the subnets ========================
+   if(tree.Format == OF_JSON) {
+      for(const size_t child : node.Children) {
+         sweep.add(*tree.Nodes[child].Block);
+      }
+      if(!node.Children.empty()) {
+         sweep.finish();
+      }
+
+      const std::string indent(1 + 3 * depth, ' ');
+      tree.OS << indent << "{ \"prefix\": \"" << blockString
+              << "\", \"addresses\": " << addresses.toString()
+              << ", \"used\": " << used
+              << ", \"utilisation\": " << format("%1.6f", utilisation) << ",\n"
+              << indent << "  \"free\": [";
+      for(size_t i = 0; i < freeList.size(); i++) {
+         tree.OS << ((i > 0) ? ", \"" : " \"") << prefixToString(freeList[i]) << "\"";
+      }
+      tree.OS << " ],\n"
+              << indent << "  \"children\": [";
+      for(size_t i = 0; i < node.Children.size(); i++) {
+         tree.OS << ((i > 0) ? ",\n" : "\n");
+         printTreeNode(tree, node.Children[i], depth + 1, blockString);
+      }
+      tree.OS << " ] }";
+      return;
+   }
+
+   // ====== Text and CSV: node, then free blocks and subnets ===============
+   if(tree.Format == OF_Text) {
+      tree.OS << std::string(3 * depth, ' ') << blockString << "  "
+              << used << "/" << addresses.toString() << "  "
+              << format("%1.2f%%", utilisation) << "\n";
+   }
+   else {
+      tree.Writer->write({ std::to_string(depth), "prefix", blockString,
+                           parentString, addresses.toString(), used,
+                           format("%1.6f", utilisation) });
+   }
+   size_t printed = 0;
+   for(const size_t child : node.Children) {
+      sweep.add(*tree.Nodes[child].Block);
+      for( ; printed < freeList.size(); printed++) {
+         printTreeFreeBlock(tree, freeList[printed], depth + 1, blockString);
+      }
+      printTreeNode(tree, child, depth + 1, blockString);
+   }
+   if(!node.Children.empty()) {
+      sweep.finish();
+   }
+   for( ; printed < freeList.size(); printed++) {
+      printTreeFreeBlock(tree, freeList[printed], depth + 1, blockString);
+   }
+}
+
+
+// ###### Print containment tree of one or more prefix lists ################
+// In sort order, a prefix comes directly after the prefixes containing it.
+// So, a single sweep with a stack holding the chain of containing prefixes
+// builds the tree in O(n log n): the top of the stack is the direct
+// supernet of the current prefix. The direct subnets of a node are
+// disjoint, so their sizes sum up to the used addresses of the node.
+bool printPrefixTree(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const int          listFiles,
+                     char**             listFileNames)
+{
+   // ====== Read prefix lists ==============================================
+   std::vector<Prefix> prefixList;
+   for(int i = 0; i < listFiles; i++) {
+      if(!readPrefixList(listFileNames[i], prefixList)) {
+         return false;
+      }
+   }
+   sortPrefixList(prefixList);
+   prefixList.erase(std::unique(prefixList.begin(), prefixList.end()),
+                    prefixList.end());
+
+   // ====== Build tree =====================================================
+   PrefixTree tree { os, outputFormat, nullptr, { }, { } };
+   tree.Nodes.reserve(prefixList.size());
+   std::vector<size_t> stack;
+   for(const Prefix& prefix : prefixList) {
+      while( (!stack.empty()) &&
+             (!containsPrefix(*tree.Nodes[stack.back()].Block, prefix)) ) {
+         stack.pop_back();
+      }
+      const size_t index = tree.Nodes.size();
+      tree.Nodes.push_back(TreeNode { &prefix, { }, WideCounter() });
+      if(stack.empty()) {
+         tree.Roots.push_back(index);
+      }
+      else {
+         TreeNode& parent = tree.Nodes[stack.back()];
+         parent.Children.push_back(index);
+         parent.Used.addPowerOfTwo(familyBits(prefix.family) - prefix.length);
+      }
+      stack.push_back(index);
+   }
+
+   // ====== Print tree =====================================================
+   if(outputFormat == OF_JSON) {
+      os << "[";
+      for(size_t i = 0; i < tree.Roots.size(); i++) {
+         os << ((i > 0) ? ",\n" : "\n");
+         printTreeNode(tree, tree.Roots[i], 0, "");
+      }
+      os << ((tree.Roots.empty()) ? "]\n" : "\n]\n");
+      os.flush();
+   }
+   else {
+      RecordWriter writer(os, outputFormat, { { "depth",       true  },
+                                              { "type",        false },
+                                              { "prefix",      false },
+                                              { "parent",      false },
+                                              { "addresses",   true  },
+                                              { "used",        true  },
+                                              { "utilisation", true  } });
+      tree.Writer = &writer;
+      for(const size_t root : tree.Roots) {
+         printTreeNode(tree, root, 0, "");
+      }
+   }
+   return true;
+}
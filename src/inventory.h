@@ -0,0 +1,56 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include "output.h"
+#include "prefixlist.h"
+
+
+bool printFreeSpace(std::ostream&      os,
+                    const OutputFormat outputFormat,
+                    const Prefix&      parent,
+                    const char*        usedListFileName,
+                    const unsigned int maxLength);
+bool printOverlaps(std::ostream&      os,
+                   const OutputFormat outputFormat,
+                   const int          listFiles,
+                   char**             listFileNames);
+bool printPrefixDiff(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const char*        oldListFileName,
+                     const char*        newListFileName);
+bool printPrefixTree(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const int          listFiles,
+                     char**             listFileNames);
+
+#endif
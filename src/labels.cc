@@ -0,0 +1,124 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "labels.h"
+
+
+bool        OutputLabelsResolved = false;
+std::string OutputLabels[OL_LabelCount];
+
+
+// ###### Set label from prefix, translated text and suffix #################
+static inline void setLabel(const OutputLabel  label,
+                            const char*        prefix,
+                            const std::string& text,
+                            const char*        suffix)
+{
+   OutputLabels[label] = prefix + text + suffix;
+}
+
+
+// ###### Translate and pre-format all labels ###############################
+void resolveOutputLabels()
+{
+   OutputLabelsResolved = true;
+
+   // ====== Result fields ==================================================
+   const char* fieldFormat = gettext("%-14s");
+   setLabel(OL_Address,      "", format(fieldFormat, gettext("Address")),       " = ");
+   setLabel(OL_Network,      "", format(fieldFormat, gettext("Network")),       " = ");
+   setLabel(OL_Netmask,      "", format(fieldFormat, gettext("Netmask")),       " = ");
+   setLabel(OL_Broadcast,    "", format(fieldFormat, gettext("Broadcast")),     " = ");
+   setLabel(OL_WildcardMask, "", format(fieldFormat, gettext("Wildcard Mask")), " = ");
+   setLabel(OL_HexAddress,   "", format(fieldFormat, gettext("Hex. Address")),  " = ");
+   setLabel(OL_HostBits,     "", format(fieldFormat, gettext("Host Bits")),     " = ");
+   setLabel(OL_MaxHosts,     "", format(fieldFormat, gettext("Max. Hosts")),    " = ");
+   setLabel(OL_HostRange,    "", format(fieldFormat, gettext("Host Range")),    " = ");
+   setLabel(OL_Properties,   "", format(fieldFormat, gettext("Properties")),    " = ");
+   setLabel(OL_BinaryIndent, "", format(fieldFormat, " "),                      "      ");
+   setLabel(OL_GeoIPASInfo,  "", format("%-14s", gettext("GeoIP AS Info")),     " = ");
+   setLabel(OL_GeoIPCountry, "", format("%-14s", gettext("GeoIP Country")),     " = ");
+   setLabel(OL_GeoIPRegion,  "", format("%-14s", gettext("GeoIP Region")),      " = ");
+   setLabel(OL_DNSHostname,  "", format("%-14s", gettext("DNS Hostname")),      " = ");
+
+   // ====== Unicast details ================================================
+   const char* detailFormat = gettext("%-32s");
+   setLabel(OL_GlobalID,              "      + ", format(detailFormat, gettext("Global ID")),    " = ");
+   setLabel(OL_SubnetID,              "      + ", format(detailFormat, gettext("Subnet ID")),    " = ");
+   setLabel(OL_InterfaceID,           "      + ", format(detailFormat, gettext("Interface ID")), " = ");
+   setLabel(OL_MACAddress,            "      + ", format(detailFormat, gettext("MAC Address")),  " = ");
+   setLabel(OL_SolicitedNodeAddress,  "      + ", format(detailFormat, gettext("Solicited Node Multicast Address")), " = ");
+   setLabel(OL_6to4Address,           "      + ", format("%-32s", gettext("6-to-4 Address")), " = ");
+
+   // ====== Property lines =================================================
+   setLabel(OL_ClassA,                "   - ", gettext("Class A"),                             "\n");
+   setLabel(OL_ClassB,                "   - ", gettext("Class B"),                             "\n");
+   setLabel(OL_ClassC,                "   - ", gettext("Class C"),                             "\n");
+   setLabel(OL_ClassD,                "   - ", gettext("Class D (Multicast)"),                 "\n");
+   setLabel(OL_InvalidClass,          "   - ", gettext("Invalid (not in class A, B, C or D)"), "\n");
+   setLabel(OL_Loopback,              "   - ", gettext("Loopback address"),                    "\n");
+   setLabel(OL_LoopbackNetwork,       "   - ", gettext("In loopback network"),                 "\n");
+   setLabel(OL_Private,               "   - ", gettext("Private"),                             "\n");
+   setLabel(OL_LinkLocal,             "   - ", gettext("Link-local address"),                  "\n");
+   setLabel(OL_Unspecified,           "   - ", gettext("Unspecified address"),                 "\n");
+   setLabel(OL_IPv4Compatible,        "   - ", gettext("IPv4-compatible IPv6 address"),        "\n");
+   setLabel(OL_IPv4Mapped,            "   - ", gettext("IPv4-mapped IPv6 address"),            "\n");
+   setLabel(OL_IPv4Embedded,          "   - ", gettext("IPv4-embedded IPv6 address"),          "\n");
+   setLabel(OL_MulticastProperties,   "   - ", gettext("Multicast Properties"),                "\n");
+   setLabel(OL_LinkLocalUnicast,      "   - ", gettext("Link-Local Unicast Properties:"),      "\n");
+   setLabel(OL_SiteLocalUnicast,      "   - ", gettext("Site-Local Unicast Properties:"),      "\n");
+   setLabel(OL_UniqueLocalUnicast,    "   - ", gettext("Unique Local Unicast Properties:"),    "\n");
+   setLabel(OL_GlobalUnicast,         "   - ", gettext("Global Unicast Properties:"),          "\n");
+
+   // ====== Property details ===============================================
+   setLabel(OL_SourceSpecific,           "      + ", gettext("Source-specific multicast"),     "\n");
+   setLabel(OL_TemporarilyAllocated,     "      + ", gettext("Temporarily-allocated address"), "\n");
+   setLabel(OL_LocallyChosen,            "      + ", gettext("Locally chosen"),                "\n");
+   setLabel(OL_AssignedByGlobalInstance, "      + ", gettext("Assigned by global instance"),   "\n");
+   const std::string scope = gettext("Scope: ");
+   setLabel(OL_ScopeNodeLocal,           "      + ", scope + gettext("node-local"),            "\n");
+   setLabel(OL_ScopeLinkLocal,           "      + ", scope + gettext("link-local"),            "\n");
+   setLabel(OL_ScopeSiteLocal,           "      + ", scope + gettext("site-local"),            "\n");
+   setLabel(OL_ScopeOrganisationLocal,   "      + ", scope + gettext("organization-local"),    "\n");
+   setLabel(OL_ScopeGlobal,              "      + ", scope + gettext("global"),                "\n");
+   setLabel(OL_ScopeUnknown,             "      + ", scope + gettext("unknown"),               "\n");
+   setLabel(OL_SolicitedNodeFor,         "      + ", gettext("Address is solicited node multicast address for"), " ");
+
+   // ====== Format strings and plain texts =================================
+   setLabel(OL_IsMulticastFormat,       "", gettext("%s is a MULTICAST address"),               "");
+   setLabel(OL_IsBroadcastFormat,       "", gettext("%s is the BROADCAST address of %s/%u"),    "");
+   setLabel(OL_IsNetworkFormat,         "", gettext("%s is a NETWORK address"),                 "");
+   setLabel(OL_IsHostFormat,            "", gettext("%s is a HOST address in %s/%u"),           "");
+   setLabel(OL_MulticastMACFormat,      "      + ", gettext("Corresponding multicast MAC address: %s"), "\n");
+   setLabel(OL_EmbeddedIPv4Format,      "      + ", gettext("Embedded IPv4 address: %s"),      "\n");
+   setLabel(OL_NotNeededOnPointToPoint, "", gettext("not needed on Point-to-Point links"),      "");
+   setLabel(OL_ReverseLookupInProgress, "", gettext("Performing reverse DNS lookup ..."),       "");
+   setLabel(OL_Unknown,                 "", gettext("Unknown"),                                 "");
+}
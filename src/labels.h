@@ -0,0 +1,129 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef LABELS_H
+#define LABELS_H
+
+#include <string>
+
+#include "tools.h"
+
+
+// ###### Output labels #####################################################
+enum OutputLabel {
+   // ====== Result fields: "<label> = " ====================================
+   OL_Address = 0,
+   OL_Network,
+   OL_Netmask,
+   OL_Broadcast,
+   OL_WildcardMask,
+   OL_HexAddress,
+   OL_HostBits,
+   OL_MaxHosts,
+   OL_HostRange,
+   OL_Properties,
+   OL_GeoIPASInfo,
+   OL_GeoIPCountry,
+   OL_GeoIPRegion,
+   OL_DNSHostname,
+   OL_BinaryIndent,
+
+   // ====== Unicast details: "      + <label> = " ==========================
+   OL_GlobalID,
+   OL_SubnetID,
+   OL_InterfaceID,
+   OL_MACAddress,
+   OL_SolicitedNodeAddress,
+   OL_6to4Address,
+
+   // ====== Property lines: "   - <label>\n" ===============================
+   OL_ClassA,
+   OL_ClassB,
+   OL_ClassC,
+   OL_ClassD,
+   OL_InvalidClass,
+   OL_Loopback,
+   OL_LoopbackNetwork,
+   OL_Private,
+   OL_LinkLocal,
+   OL_Unspecified,
+   OL_IPv4Compatible,
+   OL_IPv4Mapped,
+   OL_IPv4Embedded,
+   OL_MulticastProperties,
+   OL_LinkLocalUnicast,
+   OL_SiteLocalUnicast,
+   OL_UniqueLocalUnicast,
+   OL_GlobalUnicast,
+
+   // ====== Property details: "      + <label>\n" ==========================
+   OL_SourceSpecific,
+   OL_TemporarilyAllocated,
+   OL_LocallyChosen,
+   OL_AssignedByGlobalInstance,
+   OL_ScopeNodeLocal,
+   OL_ScopeLinkLocal,
+   OL_ScopeSiteLocal,
+   OL_ScopeOrganisationLocal,
+   OL_ScopeGlobal,
+   OL_ScopeUnknown,
+   OL_SolicitedNodeFor,
+
+   // ====== Format strings and plain texts =================================
+   OL_IsMulticastFormat,
+   OL_IsBroadcastFormat,
+   OL_IsNetworkFormat,
+   OL_IsHostFormat,
+   OL_MulticastMACFormat,
+   OL_EmbeddedIPv4Format,
+   OL_NotNeededOnPointToPoint,
+   OL_ReverseLookupInProgress,
+   OL_Unknown,
+
+   OL_LabelCount
+};
+
+
+// ###### Label table #######################################################
+// All labels are translated and padded only once, on first use, so that
+// printing a record does not need any message catalogue lookups.
+extern bool        OutputLabelsResolved;
+extern std::string OutputLabels[OL_LabelCount];
+void resolveOutputLabels();
+
+inline const std::string& outputLabel(const OutputLabel label)
+{
+   if(!OutputLabelsResolved) {
+      resolveOutputLabels();
+   }
+   return OutputLabels[label];
+}
+
+#endif
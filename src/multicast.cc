@@ -0,0 +1,466 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "multicast.h"
+#include "eui64.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+// Maximum number of groups of a list entry, and of groups enumerated for
+// a MAC address.
+static const unsigned int MaxGroupBits = 16;
+
+
+// ###### Flat hash table with linear probing ###############################
+// The capacity is a power of 2 of at least twice the maximum number of
+// entries given to the constructor, so that the table never needs to grow.
+template<typename Key, typename Value, typename Hash>
+class FlatHashTable
+{
+   public:
+   FlatHashTable(const size_t maxEntries) {
+      size_t capacity = 16;
+      while(capacity < 2 * maxEntries) {
+         capacity <<= 1;
+      }
+      Mask = capacity - 1;
+      Keys.resize(capacity);
+      Values.resize(capacity);
+      Used.resize(capacity, 0);
+   }
+
+   // Returns the value of the key. A new key is inserted with the given
+   // value, and "inserted" is set.
+   inline Value& insert(const Key& key, const Value& value, bool& inserted) {
+      size_t i = Hash()(key) & Mask;
+      while(Used[i]) {
+         if(Keys[i] == key) {
+            inserted = false;
+            return Values[i];
+         }
+         i = (i + 1) & Mask;
+      }
+      Used[i]   = 1;
+      Keys[i]   = key;
+      Values[i] = value;
+      inserted  = true;
+      return Values[i];
+   }
+
+   // Returns the value of an existing key.
+   inline const Value& operator[](const Key& key) const {
+      size_t i = Hash()(key) & Mask;
+      while(!(Keys[i] == key)) {
+         i = (i + 1) & Mask;
+      }
+      return Values[i];
+   }
+
+   private:
+   size_t             Mask;
+   std::vector<Key>   Keys;
+   std::vector<Value> Values;
+   std::vector<char>  Used;
+};
+
+struct GroupKeyHash {
+   size_t operator()(const uint64_t key) const {
+      const uint64_t h = key * 0x9e3779b97f4a7c15ULL;
+      return (size_t)(h ^ (h >> 32));
+   }
+};
+
+struct PrefixHash {
+   size_t operator()(const Prefix& prefix) const {
+      return AddressValueHash()(prefix.network) ^ GroupKeyHash()(prefix.length);
+   }
+};
+
+
+// ###### Print MAC addresses of a list of multicast groups #################
+// The entries of the list may also be prefixes or ranges of groups. The
+// groups are counted per MAC address in a hash table, so that the groups
+// sharing a MAC address are found in a single pass. Duplicate groups are
+// only counted once.
+bool printMulticastMACs(std::ostream&      os,
+                        const OutputFormat outputFormat,
+                        const char*        groupListFileName,
+                        const bool         collisionsOnly)
+{
+   // ====== Read groups ====================================================
+   std::vector<Prefix>                                groupList;
+   std::unordered_set<AddressValue, AddressValueHash> seen;
+   bool                                               valid = true;
+   if(!forEachPrefix(groupListFileName,
+                     [&](const Prefix& prefix) {
+                        if(!valid) {
+                           return;
+                        }
+                        const unsigned int bits = familyBits(prefix.family);
+                        if( (!isMulticastGroup(prefix.family, prefix.network)) ||
+                            (!isMulticastGroup(prefix.family, lastAddress(prefix))) ) {
+                           std::cerr << format(gettext("ERROR: %s is not a multicast group address!"),
+                                               prefixToString(prefix).c_str()) << "\n";
+                           valid = false;
+                           return;
+                        }
+                        if(bits - prefix.length > MaxGroupBits) {
+                           std::cerr << format(gettext("ERROR: %s contains more than 2^%u groups!"),
+                                               prefixToString(prefix).c_str(), MaxGroupBits) << "\n";
+                           valid = false;
+                           return;
+                        }
+                        Prefix             group = prefix;
+                        const unsigned int count = 1U << (bits - prefix.length);
+                        group.length = bits;
+                        for(unsigned int i = 0; i < count; i++) {
+                           group.network.low = prefix.network.low + i;
+                           if(seen.insert(group.network).second) {
+                              groupList.push_back(group);
+                           }
+                        }
+                     }) || (!valid) ) {
+      return false;
+   }
+
+   // ====== Count groups per MAC address ===================================
+   std::vector<uint64_t>                  macs(groupList.size());
+   std::unordered_map<uint64_t, uint32_t> groupsPerMAC;
+   groupsPerMAC.reserve(groupList.size());
+   for(size_t i = 0; i < groupList.size(); i++) {
+      macs[i] = multicastMAC(groupList[i].family, groupList[i].network);
+      groupsPerMAC[macs[i]]++;
+   }
+
+   // ====== Print mapping ==================================================
+   if(!collisionsOnly) {
+      RecordWriter writer(os, outputFormat, { { "group",  false },
+                                              { "mac",    false },
+                                              { "groups", true  } });
+      for(size_t i = 0; i < groupList.size(); i++) {
+         writer.write({ addressValueToString(groupList[i].family, groupList[i].network),
+                        macAddressToString(macs[i]),
+                        std::to_string(groupsPerMAC[macs[i]]) });
+      }
+      writer.finish();
+   }
+
+   // ====== Print collisions ===============================================
+   // Only the groups sharing their MAC address are sorted, by MAC address
+   // and then in the order of the list.
+   else {
+      std::vector<size_t> colliding;
+      for(size_t i = 0; i < groupList.size(); i++) {
+         if(groupsPerMAC[macs[i]] > 1) {
+            colliding.push_back(i);
+         }
+      }
+      std::stable_sort(colliding.begin(), colliding.end(),
+                       [&macs](const size_t i1, const size_t i2) {
+                          return macs[i1] < macs[i2];
+                       });
+      RecordWriter writer(os, outputFormat, { { "mac",    false },
+                                              { "groups", true  },
+                                              { "group",  false } });
+      for(const size_t i : colliding) {
+         writer.write({ macAddressToString(macs[i]),
+                        std::to_string(groupsPerMAC[macs[i]]),
+                        addressValueToString(groupList[i].family, groupList[i].network) });
+      }
+      writer.finish();
+   }
+   return true;
+}
+
+
+// ###### Print all multicast groups mapping to a MAC address ###############
+// Without range, all groups of the family's multicast address space are
+// enumerated. This is only possible for IPv4; for IPv6, 2^88 groups share
+// each MAC address.
+bool printMulticastGroups(std::ostream&      os,
+                          const OutputFormat outputFormat,
+                          const char*        macString,
+                          const char*        rangeString)
+{
+   // ====== Get family and fixed lower bits of the MAC address =============
+   uint64_t mac;
+   if(!parseMACAddress(macString, strlen(macString), mac)) {
+      std::cerr << format(gettext("ERROR: Invalid MAC address %s!"), macString) << "\n";
+      return false;
+   }
+   unsigned int family;
+   unsigned int fixedBits;
+   if((mac & 0xffffff800000ULL) == 0x01005e000000ULL) {
+      family    = AF_INET;
+      fixedBits = 23;
+   }
+   else if((mac >> 32) == 0x3333) {
+      family    = AF_INET6;
+      fixedBits = 32;
+   }
+   else {
+      std::cerr << format(gettext("ERROR: %s is not a multicast MAC address!"), macString) << "\n";
+      return false;
+   }
+   const uint64_t fixedMask = (1ULL << fixedBits) - 1;
+   const uint64_t fixed     = mac & fixedMask;
+
+   // ====== Get multicast part of the range ================================
+   const Prefix multicastSpace = (family == AF_INET) ?
+      Prefix { { 0, 0xe0000000ULL }, AF_INET, 4, 0 } :
+      Prefix { { 0xff00000000000000ULL, 0 }, AF_INET6, 8, 0 };
+   Prefix range = multicastSpace;
+   if(rangeString != nullptr) {
+      if(!parsePrefix(rangeString, range)) {
+         std::cerr << format(gettext("ERROR: Invalid address %s!"), rangeString) << "\n";
+         return false;
+      }
+      if(containsPrefix(range, multicastSpace)) {
+         range = multicastSpace;
+      }
+      else if(!containsPrefix(multicastSpace, range)) {
+         std::cerr << format(gettext("ERROR: %s is not within the multicast address space!"),
+                             rangeString) << "\n";
+         return false;
+      }
+   }
+
+   // ====== Enumerate groups ===============================================
+   // The bits between the prefix and the fixed lower bits are free. A
+   // prefix longer than that also fixes some of the lower bits, which then
+   // have to match the MAC address.
+   const unsigned int bits     = familyBits(family);
+   const unsigned int freeBits = (range.length < bits - fixedBits) ?
+                                    bits - fixedBits - range.length : 0;
+   if(freeBits > MaxGroupBits) {
+      std::cerr << format(gettext("ERROR: More than 2^%u groups map to %s within %s!"),
+                          MaxGroupBits, macString,
+                          prefixToString(range).c_str()) << "\n";
+      return false;
+   }
+   RecordWriter writer(os, outputFormat, { { "group", false },
+                                           { "mac",   false } });
+   if( ((range.network.low ^ fixed) & fixedMask & netMask(family, range.length).low) == 0 ) {
+      const std::string macAddressString = macAddressToString(mac);
+      for(uint64_t i = 0; i < (1ULL << freeBits); i++) {
+         const AddressValue group { range.network.high,
+                                    range.network.low | (i << fixedBits) | fixed };
+         writer.write({ addressValueToString(family, group), macAddressString });
+      }
+   }
+   writer.finish();
+   return true;
+}
+
+
+// ###### Read IPv6 host addresses with subnet ("-" for standard input) #####
+// An address without prefix length belongs to its subnet of the default
+// prefix length.
+static bool readHostList(const char*                fileName,
+                         const unsigned int         defaultPrefixLength,
+                         std::vector<AddressValue>& hostList,
+                         std::vector<uint8_t>&      lengthList)
+{
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(fileName, "-") != 0) {
+      fileStream.open(fileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   std::string  line;
+   unsigned int lineNumber = 0;
+   AddressValue address;
+   unsigned int family;
+   unsigned int length;
+   while(std::getline(*is, line)) {
+      lineNumber++;
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      const size_t end = line.find_first_of(" \t\r,#", begin);
+      if(end != std::string::npos) {
+         line.resize(end);
+      }
+      if( (!parseAddressPrefix(line.c_str() + begin, address, family, length)) ||
+          (family != AF_INET6) ) {
+         std::cerr << format(gettext("ERROR: Invalid IPv6 address %s in %s, line %u!"),
+                             line.c_str() + begin, fileName, lineNumber) << "\n";
+         return false;
+      }
+      if(strchr(line.c_str() + begin, '/') == nullptr) {
+         length = defaultPrefixLength;
+      }
+      hostList.push_back(address);
+      lengthList.push_back((uint8_t)length);
+   }
+   return true;
+}
+
+
+// ###### Print solicited-node multicast group load per subnet ##############
+// Each subnet is a link, on which every host joins the solicited-node group
+// of each of its addresses. With MLD snooping, every group needs an entry
+// in the switch's table, and hosts sharing a group receive each other's
+// neighbour solicitations. The groups are counted in flat hash tables
+// sized to the input, keyed by subnet number and the lower 24 bits of the
+// address. Subnets are identified by network address and prefix length, so
+// that e.g. a /48 and a /64 at the same address are different links.
+// Duplicate addresses are counted once.
+bool printSolicitedNodeLoad(std::ostream&      os,
+                            const OutputFormat outputFormat,
+                            const char*        addressListFileName,
+                            const unsigned int defaultPrefixLength,
+                            const unsigned int tableSize,
+                            const bool         collisionsOnly)
+{
+   std::vector<AddressValue> hostList;
+   std::vector<uint8_t>      lengthList;
+   if(!readHostList(addressListFileName, defaultPrefixLength, hostList, lengthList)) {
+      return false;
+   }
+
+   // ====== Assign hosts to subnets and groups =============================
+   struct Subnet {
+      Prefix             Network;
+      unsigned long long Hosts;
+      unsigned long long Groups;
+      unsigned long long LargestGroup;
+      unsigned long long CollidingHosts;
+   };
+   std::vector<Subnet>                                       subnetList;
+   std::vector<uint64_t>                                     groupKeys;
+   std::vector<size_t>                                       uniqueHosts;
+   FlatHashTable<Prefix, uint32_t, PrefixHash>               subnetIndex(hostList.size());
+   FlatHashTable<AddressValue, char, AddressValueHash>       hosts(hostList.size());
+   FlatHashTable<uint64_t, unsigned long long, GroupKeyHash> groupMembers(hostList.size());
+   groupKeys.reserve(hostList.size());
+   uniqueHosts.reserve(hostList.size());
+   bool inserted;
+   for(size_t i = 0; i < hostList.size(); i++) {
+      hosts.insert(hostList[i], 0, inserted);
+      if(!inserted) {
+         continue;
+      }
+      const Prefix   network { hostList[i] & netMask<AF_INET6>(lengthList[i]),
+                               AF_INET6, lengthList[i], 0 };
+      const uint32_t subnet = subnetIndex.insert(network, (uint32_t)subnetList.size(), inserted);
+      if(inserted) {
+         subnetList.push_back(Subnet { network, 0, 0, 0, 0 });
+      }
+      const uint64_t      key     = ((uint64_t)subnet << 24) | (hostList[i].low & 0x00ffffffULL);
+      unsigned long long& members = groupMembers.insert(key, 0, inserted);
+      members++;
+      Subnet& s = subnetList[subnet];
+      s.Hosts++;
+      if(inserted) {
+         s.Groups++;
+      }
+      s.LargestGroup = std::max(s.LargestGroup, members);
+      s.CollidingHosts += (members == 2) ? 2 : ((members > 2) ? 1 : 0);
+      groupKeys.push_back(key);
+      uniqueHosts.push_back(i);
+   }
+
+   // ====== Print groups with more than one member =========================
+   if(collisionsOnly) {
+      std::vector<size_t> colliding;
+      for(size_t j = 0; j < uniqueHosts.size(); j++) {
+         if(groupMembers[groupKeys[j]] > 1) {
+            colliding.push_back(j);
+         }
+      }
+      std::sort(colliding.begin(), colliding.end(),
+                [&](const size_t j1, const size_t j2) {
+                   const Prefix& s1 = subnetList[groupKeys[j1] >> 24].Network;
+                   const Prefix& s2 = subnetList[groupKeys[j2] >> 24].Network;
+                   if(!(s1 == s2)) {
+                      return s1 < s2;
+                   }
+                   if((groupKeys[j1] & 0xffffff) != (groupKeys[j2] & 0xffffff)) {
+                      return (groupKeys[j1] & 0xffffff) < (groupKeys[j2] & 0xffffff);
+                   }
+                   return hostList[uniqueHosts[j1]] < hostList[uniqueHosts[j2]];
+                });
+      RecordWriter writer(os, outputFormat, { { "subnet",  false },
+                                              { "group",   false },
+                                              { "members", true  },
+                                              { "address", false } });
+      for(const size_t j : colliding) {
+         const AddressValue& host = hostList[uniqueHosts[j]];
+         writer.write({ prefixToString(subnetList[groupKeys[j] >> 24].Network),
+                        addressValueToString(AF_INET6, solicitedNodeAddress(host)),
+                        std::to_string(groupMembers[groupKeys[j]]),
+                        addressValueToString(AF_INET6, host) });
+      }
+      writer.finish();
+      return true;
+   }
+
+   // ====== Print load per subnet ==========================================
+   std::sort(subnetList.begin(), subnetList.end(),
+             [](const Subnet& s1, const Subnet& s2) {
+                return s1.Network < s2.Network;
+             });
+   RecordWriter writer(os, outputFormat, { { "subnet",          false },
+                                           { "hosts",           true  },
+                                           { "groups",          true  },
+                                           { "largest_group",   true  },
+                                           { "colliding_hosts", true  },
+                                           { "table_usage",     true  } });
+   for(const Subnet& subnet : subnetList) {
+      const std::string subnetString = prefixToString(subnet.Network);
+      writer.write({ subnetString,
+                     std::to_string(subnet.Hosts),
+                     std::to_string(subnet.Groups),
+                     std::to_string(subnet.LargestGroup),
+                     std::to_string(subnet.CollidingHosts),
+                     format("%1.2f", 100.0 * (double)subnet.Groups / (double)tableSize) });
+      if(subnet.Groups > tableSize) {
+         std::cerr << format(gettext("WARNING: %s needs %llu solicited-node groups, more than %u table entries!"),
+                             subnetString.c_str(), subnet.Groups, tableSize) << "\n";
+      }
+   }
+   writer.finish();
+   return true;
+}
@@ -0,0 +1,87 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef MULTICAST_H
+#define MULTICAST_H
+
+#include <cstdint>
+
+#include "output.h"
+#include "prefixlist.h"
+
+
+// ###### Check whether an address is a multicast group address #############
+inline bool isMulticastGroup(const unsigned int family, const AddressValue& address)
+{
+   if(family == AF_INET) {
+      return (address.low >> 28) == 0xe;    // 224.0.0.0/4
+   }
+   return (address.high >> 56) == 0xff;     // ff00::/8
+}
+
+
+// ###### Get MAC address of a multicast group ##############################
+// IPv4 (RFC 1112): 01:00:5e, followed by the lower 23 bits of the group,
+// so that 32 groups share each MAC address.
+// IPv6 (RFC 2464): 33:33, followed by the lower 32 bits of the group.
+inline uint64_t multicastMAC(const unsigned int family, const AddressValue& group)
+{
+   if(family == AF_INET) {
+      return 0x01005e000000ULL | (group.low & 0x007fffffULL);
+   }
+   return 0x333300000000ULL | (group.low & 0xffffffffULL);
+}
+
+
+// ###### Get solicited-node multicast address #############################
+// ff02::1:ffXX:XXXX (RFC 4291, Subsection 2.7.1)
+inline AddressValue solicitedNodeAddress(const AddressValue& address)
+{
+   return AddressValue { 0xff02000000000000ULL,
+                         0x00000001ff000000ULL | (address.low & 0x00ffffffULL) };
+}
+
+
+bool printMulticastMACs(std::ostream&      os,
+                        const OutputFormat outputFormat,
+                        const char*        groupListFileName,
+                        const bool         collisionsOnly);
+bool printMulticastGroups(std::ostream&      os,
+                          const OutputFormat outputFormat,
+                          const char*        macString,
+                          const char*        rangeString);
+bool printSolicitedNodeLoad(std::ostream&      os,
+                            const OutputFormat outputFormat,
+                            const char*        addressListFileName,
+                            const unsigned int defaultPrefixLength,
+                            const unsigned int tableSize,
+                            const bool         collisionsOnly);
+
+#endif
@@ -0,0 +1,90 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "nat64.h"
+
+#include <iostream>
+
+
+// ###### Map IPv4 addresses to IPv6 addresses and vice versa ###############
+// IPv4 addresses are embedded into the translation prefix, IPv6 addresses
+// within the translation prefix are mapped back to their IPv4 address
+// (RFC 6052). Other IPv6 addresses are skipped with a warning.
+bool printNAT64Mapping(std::ostream&      os,
+                       const OutputFormat outputFormat,
+                       const char*        addressListFileName,
+                       const Prefix&      translationPrefix)
+{
+   std::vector<Prefix> addressList;
+   if(!readPrefixList(addressListFileName, addressList)) {
+      return false;
+   }
+
+   sockaddr_union prefix;
+   valueToAddress(AF_INET6, translationPrefix.network, prefix);
+   const AddressValue mask = netMask<AF_INET6>(translationPrefix.length);
+
+   RecordWriter   writer(os, outputFormat, { { "ipv4", false },
+                                             { "ipv6", false } });
+   sockaddr_union ipv4address;
+   sockaddr_union ipv6address;
+   for(const Prefix& address : addressList) {
+      if(address.length != familyBits(address.family)) {
+         std::cerr << format(gettext("WARNING: Skipping prefix %s, since it is not an address!"),
+                             prefixToString(address).c_str()) << "\n";
+         continue;
+      }
+      if(address.family == AF_INET) {
+         valueToAddress(AF_INET, address.network, ipv4address);
+         valueToAddress(AF_INET6, AddressValue { 0, 0 }, ipv6address);
+         embedIPv4Address(ipv6address.in6.sin6_addr, prefix.in6.sin6_addr,
+                          translationPrefix.length, ipv4address.in.sin_addr);
+      }
+      else {
+         if((address.network & mask) != translationPrefix.network) {
+            std::cerr << format(gettext("WARNING: Skipping address %s, since it is not in the translation prefix!"),
+                                addressValueToString(AF_INET6, address.network).c_str()) << "\n";
+            continue;
+         }
+         valueToAddress(AF_INET6, address.network, ipv6address);
+         valueToAddress(AF_INET, AddressValue { 0, 0 }, ipv4address);
+         extractIPv4Address(ipv6address.in6.sin6_addr, translationPrefix.length,
+                            ipv4address.in.sin_addr);
+      }
+
+      char ipv4String[64];
+      char ipv6String[128];
+      address2string(&ipv4address.sa, ipv4String, sizeof(ipv4String), false, true);
+      address2string(&ipv6address.sa, ipv6String, sizeof(ipv6String), false, true);
+      writer.write({ ipv4String, ipv6String });
+   }
+   writer.finish();
+   return true;
+}
@@ -0,0 +1,191 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "output.h"
+#include "tools.h"
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+
+// ###### Parse output format name ##########################################
+bool parseOutputFormat(const char* string, OutputFormat& outputFormat)
+{
+   if(strcmp(string, "text") == 0) {
+      outputFormat = OF_Text;
+   }
+   else if(strcmp(string, "csv") == 0) {
+      outputFormat = OF_CSV;
+   }
+   else if(strcmp(string, "json") == 0) {
+      outputFormat = OF_JSON;
+   }
+   else {
+      return false;
+   }
+   return true;
+}
+
+
+// ###### Write CSV value (quoted if necessary) ##############################
+static void writeCSVValue(std::ostream& os, const std::string& value)
+{
+   if(value.find_first_of(",\"\r\n") == std::string::npos) {
+      os << value;
+   }
+   else {
+      os << '"';
+      for(const char c : value) {
+         if(c == '"') {
+            os << '"';
+         }
+         os << c;
+      }
+      os << '"';
+   }
+}
+
+
+// ###### Write JSON string ##################################################
+static void writeJSONString(std::ostream& os, const std::string& value)
+{
+   os << '"';
+   for(const char c : value) {
+      switch(c) {
+         case '"':
+            os << "\\\"";
+            break;
+         case '\\':
+            os << "\\\\";
+            break;
+         case '\n':
+            os << "\\n";
+            break;
+         case '\r':
+            os << "\\r";
+            break;
+         case '\t':
+            os << "\\t";
+            break;
+         default:
+            if((unsigned char)c < 0x20) {
+               os << format("\\u%04x", (unsigned int)c);
+            }
+            else {
+               os << c;
+            }
+            break;
+      }
+   }
+   os << '"';
+}
+
+
+// ###### Constructor #######################################################
+RecordWriter::RecordWriter(std::ostream&                   os,
+                           const OutputFormat              outputFormat,
+                           const std::vector<RecordField>& fields)
+   : OS(os),
+     Format(outputFormat),
+     Fields(fields)
+{
+   Records  = 0;
+   Finished = false;
+   if(Format == OF_CSV) {
+      for(size_t i = 0; i < Fields.size(); i++) {
+         OS << ((i > 0) ? "," : "") << Fields[i].name;
+      }
+      OS << "\n";
+   }
+   else if(Format == OF_JSON) {
+      OS << "[";
+   }
+}
+
+
+// ###### Destructor ########################################################
+RecordWriter::~RecordWriter()
+{
+   finish();
+}
+
+
+// ###### Write record ######################################################
+void RecordWriter::write(const std::vector<std::string>& values)
+{
+   assert(values.size() == Fields.size());
+   assert(!Finished);
+
+   switch(Format) {
+      case OF_Text:
+         for(size_t i = 0; i < values.size(); i++) {
+            OS << ((i > 0) ? "  " : "") << values[i];
+         }
+         OS << "\n";
+         break;
+      case OF_CSV:
+         for(size_t i = 0; i < values.size(); i++) {
+            if(i > 0) {
+               OS << ",";
+            }
+            writeCSVValue(OS, values[i]);
+         }
+         OS << "\n";
+         break;
+      case OF_JSON:
+         OS << ((Records > 0) ? ",\n " : "\n ") << "{ ";
+         for(size_t i = 0; i < values.size(); i++) {
+            OS << ((i > 0) ? ", \"" : "\"") << Fields[i].name << "\": ";
+            if( (Fields[i].isNumber) && (!values[i].empty()) ) {
+               OS << values[i];
+            }
+            else {
+               writeJSONString(OS, values[i]);
+            }
+         }
+         OS << " }";
+         break;
+   }
+   Records++;
+}
+
+
+// ###### Finish output #####################################################
+void RecordWriter::finish()
+{
+   if(!Finished) {
+      Finished = true;
+      if(Format == OF_JSON) {
+         OS << ((Records > 0) ? "\n]\n" : "]\n");
+      }
+      OS.flush();
+   }
+}
@@ -0,0 +1,581 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+#include "prefixlist.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+
+// ###### Convert address into 128-bit value ################################
+void addressToValue(const sockaddr_union& address, AddressValue& value)
+{
+   if(address.sa.sa_family == AF_INET) {
+      value.high = 0;
+      value.low  = ntohl(address.in.sin_addr.s_addr);
+   }
+   else {
+      const uint8_t* b = address.in6.sin6_addr.s6_addr;
+      value.high = 0;
+      value.low  = 0;
+      for(int i = 0; i < 8; i++) {
+         value.high = (value.high << 8) | b[i];
+         value.low  = (value.low  << 8) | b[i + 8];
+      }
+   }
+}
+
+
+// ###### Convert 128-bit value into address ################################
+void valueToAddress(const unsigned int  family,
+                    const AddressValue& value,
+                    sockaddr_union&     address)
+{
+   memset(&address, 0, sizeof(address));
+   if(family == AF_INET) {
+      address.in.sin_family      = AF_INET;
+      address.in.sin_addr.s_addr = htonl((uint32_t)value.low);
+#ifdef HAVE_SIN_LEN
+      address.in.sin_len         = sizeof(struct sockaddr_in);
+#endif
+   }
+   else {
+      address.in6.sin6_family = AF_INET6;
+      uint8_t* b = address.in6.sin6_addr.s6_addr;
+      for(int i = 7; i >= 0; i--) {
+         b[i]     = (uint8_t)(value.high >> (8 * (7 - i)));
+         b[i + 8] = (uint8_t)(value.low  >> (8 * (7 - i)));
+      }
+#ifdef HAVE_SIN6_LEN
+      address.in6.sin6_len    = sizeof(struct sockaddr_in6);
+#endif
+   }
+}
+
+
+// ###### Create normalised prefix from address and prefix length ###########
+void makePrefix(const sockaddr_union& network,
+                const unsigned int    length,
+                Prefix&               prefix)
+{
+   addressToValue(network, prefix.network);
+   prefix.family  = network.sa.sa_family;
+   prefix.length  = length;
+   prefix.source  = 0;
+   // Same normalisation as "network = address & netmask":
+   prefix.network = prefix.network & netMask(prefix.family, length);
+}
+
+
+// ###### Parse numeric IPv4 address (dotted quad) ##########################
+// NOTE: Like inet_pton(), leading zeros are not accepted.
+bool parseIPv4Address(const char* string, const size_t length, AddressValue& value)
+{
+   const char*  p      = string;
+   const char*  end    = string + length;
+   uint32_t     result = 0;
+   for(unsigned int i = 0; i < 4; i++) {
+      if( (i > 0) && ((p >= end) || (*p++ != '.')) ) {
+         return false;
+      }
+      const char* start = p;
+      unsigned int octet = 0;
+      while( (p < end) && ((unsigned int)(*p - '0') <= 9) ) {
+         octet = (octet * 10) + (*p - '0');
+         p++;
+         if( (p - start > 3) || ((p - start > 1) && (*start == '0')) ) {
+            return false;
+         }
+      }
+      if( (p == start) || (octet > 255) ) {
+         return false;
+      }
+      result = (result << 8) | octet;
+   }
+   if(p != end) {
+      return false;
+   }
+   value.high = 0;
+   value.low  = result;
+   return true;
+}
+
+
+// ###### Get value of hexadecimal digit ####################################
+static inline int hexDigitValue(const char c)
+{
+   if((unsigned int)(c - '0') <= 9) {
+      return c - '0';
+   }
+   const char l = c | 0x20;
+   if((l >= 'a') && (l <= 'f')) {
+      return l - 'a' + 10;
+   }
+   return -1;
+}
+
+
+// ###### Parse numeric IPv6 address (RFC 4291 text representation) #########
+bool parseIPv6Address(const char* string, const size_t length, AddressValue& value)
+{
+   uint16_t    words[8];
+   int         n           = 0;
+   int         doubleColon = -1;
+   const char* p           = string;
+   const char* end         = string + length;
+
+   if( (p < end) && (*p == ':') ) {
+      if( (end - p < 2) || (p[1] != ':') ) {
+         return false;
+      }
+      doubleColon = 0;
+      p += 2;
+   }
+   while(p < end) {
+      // ====== Group of up to 4 hex digits =================================
+      const char* start = p;
+      uint32_t    word  = 0;
+      int         digit;
+      while( (p < end) && ((digit = hexDigitValue(*p)) >= 0) ) {
+         word = (word << 4) | digit;
+         p++;
+      }
+
+      // ====== Embedded IPv4 address in the last 32 bits ===================
+      if( (p < end) && (*p == '.') ) {
+         AddressValue ipv4;
+         if( (n > 6) || (!parseIPv4Address(start, end - start, ipv4)) ) {
+            return false;
+         }
+         words[n++] = (uint16_t)(ipv4.low >> 16);
+         words[n++] = (uint16_t)(ipv4.low & 0xffff);
+         p = end;
+         break;
+      }
+
+      if( (p == start) || (p - start > 4) || (n >= 8) ) {
+         return false;
+      }
+      words[n++] = (uint16_t)word;
+      if(p == end) {
+         break;
+      }
+      if(*p++ != ':') {
+         return false;
+      }
+      if( (p < end) && (*p == ':') ) {
+         if(doubleColon >= 0) {
+            return false;
+         }
+         doubleColon = n;
+         p++;
+      }
+      else if(p == end) {
+         return false;   // Trailing single ":"
+      }
+   }
+
+   // ====== Expand "::" ====================================================
+   if(doubleColon >= 0) {
+      if(n >= 8) {
+         return false;
+      }
+      const int moved = n - doubleColon;
+      for(int i = 0; i < moved; i++) {
+         words[7 - i] = words[n - 1 - i];
+      }
+      for(int i = doubleColon; i < 8 - moved; i++) {
+         words[i] = 0;
+      }
+   }
+   else if(n != 8) {
+      return false;
+   }
+
+   value.high = ((uint64_t)words[0] << 48) | ((uint64_t)words[1] << 32) |
+                ((uint64_t)words[2] << 16) | (uint64_t)words[3];
+   value.low  = ((uint64_t)words[4] << 48) | ((uint64_t)words[5] << 32) |
+                ((uint64_t)words[6] << 16) | (uint64_t)words[7];
+   return true;
+}
+
+
+// ###### Parse "address[/length]" or "address/netmask" #####################
+// NOTE: Only numeric addresses are accepted, i.e. no DNS lookups are made.
+// Unlike parsePrefix(), the address is not normalised.
+bool parseAddressPrefix(const char*   string,
+                        AddressValue& address,
+                        unsigned int& family,
+                        unsigned int& length)
+{
+   const char*  slash      = strchr(string, '/');
+   const size_t hostLength = (slash != nullptr) ? (size_t)(slash - string) : strlen(string);
+
+   // ====== Parse address ==================================================
+   if(memchr(string, ':', hostLength) != nullptr) {
+      if(!parseIPv6Address(string, hostLength, address)) {
+         return false;
+      }
+      family = AF_INET6;
+   }
+   else {
+      if(!parseIPv4Address(string, hostLength, address)) {
+         return false;
+      }
+      family = AF_INET;
+   }
+
+   // ====== Parse prefix length or netmask =================================
+   const unsigned int bits = familyBits(family);
+   length = bits;
+   if(slash != nullptr) {
+      const char* p = &slash[1];
+      if(*p == 0x00) {
+         return false;
+      }
+      bool isNumber = true;
+      for(const char* q = p; *q != 0x00; q++) {
+         if(!isdigit(static_cast<unsigned char>(*q))) {
+            isNumber = false;
+            break;
+         }
+      }
+      if(isNumber) {
+         if(strlen(p) > 3) {
+            return false;
+         }
+         length = (unsigned int)atoi(p);
+         if(length > bits) {
+            return false;
+         }
+      }
+      else {
+         Prefix maskPrefix;
+         if( (strchr(p, '/') != nullptr) || (!parsePrefix(p, maskPrefix)) ||
+             (maskPrefix.family != family) ) {
+            return false;
+         }
+         const AddressValue& mask = maskPrefix.network;
+         for(length = 0; length < bits; length++) {
+            const AddressValue m = netMask(family, length + 1);
+            if((mask & m) != m) {
+               break;
+            }
+         }
+         if(mask != netMask(family, length)) {
+            return false;   // Non-contiguous netmask
+         }
+      }
+   }
+   return true;
+}
+
+
+// ###### Parse prefix "address[/length]" or "address/netmask" ##############
+// NOTE: Only numeric addresses are accepted, i.e. no DNS lookups are made.
+bool parsePrefix(const char* string, Prefix& prefix)
+{
+   AddressValue address;
+   unsigned int family;
+   unsigned int length;
+   if(!parseAddressPrefix(string, address, family, length)) {
+      return false;
+   }
+
+   // Same normalisation as "network = address & netmask":
+   prefix.network = address & netMask(family, length);
+   prefix.family  = family;
+   prefix.length  = length;
+   prefix.source  = 0;
+   return true;
+}
+
+
+// ###### Constructor #######################################################
+PrefixListReader::PrefixListReader(const char* fileName, const uint32_t source)
+   : FileName(fileName),
+     Source(source)
+{
+   IS         = &std::cin;
+   LineNumber = 0;
+   RangeIndex = 0;
+   Failed     = false;
+   if(strcmp(fileName, "-") != 0) {
+      FileStream.open(fileName);
+      if(!FileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+         Failed = true;
+      }
+      IS = &FileStream;
+   }
+}
+
+
+// ###### Get next prefix ###################################################
+// Empty lines and comments (starting with "#") are skipped. Only the first
+// token (separated by whitespace or ",") of each line is used. Address
+// ranges "first-last" are split into their CIDR prefixes.
+bool PrefixListReader::next(Prefix& prefix)
+{
+   // ====== Remaining prefixes of an address range =========================
+   if(RangeIndex < RangePrefixes.size()) {
+      prefix = RangePrefixes[RangeIndex++];
+      return true;
+   }
+
+   while( (!Failed) && (std::getline(*IS, Line)) ) {
+      LineNumber++;
+      const size_t begin = Line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (Line[begin] == '#') ) {
+         continue;
+      }
+      const size_t end = Line.find_first_of(" \t\r,#", begin);
+      if(end != std::string::npos) {
+         Line.resize(end);
+      }
+      const char* token = Line.c_str() + begin;
+      const char* dash  = strchr(token, '-');
+      if(dash != nullptr) {
+         // ====== Address range "first-last" ===============================
+         const std::string firstString(token, dash - token);
+         Prefix            last;
+         if( (!parsePrefix(firstString.c_str(), prefix)) || (!parsePrefix(&dash[1], last)) ||
+             (prefix.length != familyBits(prefix.family)) ||
+             (last.length != familyBits(last.family)) ||
+             (prefix.family != last.family) || (last.network < prefix.network) ) {
+            std::cerr << format(gettext("ERROR: Invalid address range %s in %s, line %u!"),
+                                token, FileName, LineNumber) << "\n";
+            Failed = true;
+            return false;
+         }
+         RangePrefixes.clear();
+         rangeToPrefixes(prefix.family, prefix.network, last.network, RangePrefixes);
+         for(Prefix& rangePrefix : RangePrefixes) {
+            rangePrefix.source = Source;
+         }
+         prefix     = RangePrefixes[0];
+         RangeIndex = 1;
+         return true;
+      }
+      if(!parsePrefix(token, prefix)) {
+         std::cerr << format(gettext("ERROR: Invalid prefix %s in %s, line %u!"),
+                             token, FileName, LineNumber) << "\n";
+         Failed = true;
+         return false;
+      }
+      prefix.source = Source;
+      return true;
+   }
+   return false;
+}
+
+
+// ###### Read prefixes from file ("-" for standard input) ##################
+// The handler is called for each prefix, i.e. the prefixes are not stored.
+bool forEachPrefix(const char*          fileName,
+                   const PrefixHandler& handler,
+                   const uint32_t       source)
+{
+   PrefixListReader reader(fileName, source);
+   Prefix           prefix;
+   while(reader.next(prefix)) {
+      handler(prefix);
+   }
+   return !reader.failed();
+}
+
+
+// ###### Read prefix list from file ("-" for standard input) ###############
+bool readPrefixList(const char*          fileName,
+                    std::vector<Prefix>& prefixList,
+                    const uint32_t       source)
+{
+   return forEachPrefix(fileName,
+                        [&prefixList](const Prefix& prefix) {
+                           prefixList.push_back(prefix);
+                        },
+                        source);
+}
+
+
+// ###### Read address list from file ("-" for standard input) ##############
+// Like readPrefixList(), but without masking: for "2001:db8::1/64", the
+// entry contains the address 2001:db8::1 (with length 64). Ranges are not
+// supported.
+bool readAddressList(const char*          fileName,
+                     std::vector<Prefix>& addressList)
+{
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(fileName, "-") != 0) {
+      fileStream.open(fileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   std::string  line;
+   unsigned int lineNumber = 0;
+   AddressValue address;
+   unsigned int family;
+   unsigned int length;
+   while(std::getline(*is, line)) {
+      lineNumber++;
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      const size_t end = line.find_first_of(" \t\r,#", begin);
+      if(end != std::string::npos) {
+         line.resize(end);
+      }
+      if(!parseAddressPrefix(line.c_str() + begin, address, family, length)) {
+         std::cerr << format(gettext("ERROR: Invalid address %s in %s, line %u!"),
+                             line.c_str() + begin, fileName, lineNumber) << "\n";
+         return false;
+      }
+      addressList.push_back(Prefix { address, (uint8_t)family, (uint8_t)length, 0 });
+   }
+   return true;
+}
+
+
+// ###### Split list argument "[label=]file" ################################
+// Returns the file name. If no label is given, the file name is the label.
+const char* parseListArgument(const char* argument, std::string& label)
+{
+   const char* equals = strchr(argument, '=');
+   if( (equals != nullptr) && (memchr(argument, '/', equals - argument) == nullptr) ) {
+      label = std::string(argument, equals - argument);
+      return &equals[1];
+   }
+   label = argument;
+   return argument;
+}
+
+
+// ###### Sort prefix list by family, network, prefix length and source #####
+void sortPrefixList(std::vector<Prefix>& prefixList)
+{
+   std::sort(prefixList.begin(), prefixList.end(),
+             [](const Prefix& p1, const Prefix& p2) {
+                if(p1 == p2) {
+                   return p1.source < p2.source;
+                }
+                return p1 < p2;
+             });
+}
+
+
+// ###### Find most significant bit #########################################
+static inline int highestBit(const AddressValue& value)
+{
+   if(value.high != 0) {
+      return 127 - __builtin_clzll(value.high);
+   }
+   if(value.low != 0) {
+      return 63 - __builtin_clzll(value.low);
+   }
+   return -1;
+}
+
+
+// ###### Count trailing zero bits ##########################################
+static inline unsigned int trailingZeros(const AddressValue& value,
+                                         const unsigned int  bits)
+{
+   if(value.low != 0) {
+      return std::min((unsigned int)__builtin_ctzll(value.low), bits);
+   }
+   if( (bits > 64) && (value.high != 0) ) {
+      return 64 + __builtin_ctzll(value.high);
+   }
+   return bits;
+}
+
+
+// ###### Split address range into minimal set of CIDR prefixes #############
+void rangeToPrefixes(const unsigned int   family,
+                     AddressValue         first,
+                     const AddressValue&  last,
+                     std::vector<Prefix>& prefixList)
+{
+   const unsigned int bits = familyBits(family);
+   assert(first <= last);
+
+   for(;;) {
+      // ====== Largest aligned block starting at "first" within range ======
+      const AddressValue span     = subtract(last, first);   // Size - 1
+      const AddressValue allBits  = hostMask(family, 0);
+      unsigned int       sizeBits = (span == allBits) ? bits :
+                                       (unsigned int)highestBit(increment(span));
+      sizeBits = std::min(sizeBits, trailingZeros(first, bits));
+
+      Prefix prefix;
+      prefix.family  = family;
+      prefix.length  = bits - sizeBits;
+      prefix.network = first;
+      prefix.source  = 0;
+      prefixList.push_back(prefix);
+
+      const AddressValue blockLast = lastAddress(prefix);
+      if(blockLast == last) {
+         break;
+      }
+      first = increment(blockLast);
+   }
+}
+
+
+// ###### Convert 128-bit value to address string ###########################
+std::string addressValueToString(const unsigned int  family,
+                                 const AddressValue& value)
+{
+   sockaddr_union address;
+   char           str[128];
+   valueToAddress(family, value, address);
+   if(!address2string(&address.sa, str, sizeof(str), false, true)) {
+      return "(invalid!)";
+   }
+   return std::string(str);
+}
+
+
+// ###### Convert prefix to string ##########################################
+std::string prefixToString(const Prefix& prefix)
+{
+   return addressValueToString(prefix.family, prefix.network) + "/" +
+             std::to_string((unsigned int)prefix.length);
+}
@@ -0,0 +1,288 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+#ifndef PREFIXLIST_H
+#define PREFIXLIST_H
+
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "tools.h"
+
+
+// ###### 128-bit address value in host byte order ##########################
+// IPv4 addresses are stored in the lower 32 bits of "low".
+struct AddressValue {
+   uint64_t high;
+   uint64_t low;
+};
+
+inline bool operator==(const AddressValue& a1, const AddressValue& a2)
+{
+   return (a1.high == a2.high) && (a1.low == a2.low);
+}
+
+inline bool operator!=(const AddressValue& a1, const AddressValue& a2)
+{
+   return !(a1 == a2);
+}
+
+inline bool operator<(const AddressValue& a1, const AddressValue& a2)
+{
+   return (a1.high < a2.high) || ((a1.high == a2.high) && (a1.low < a2.low));
+}
+
+inline bool operator<=(const AddressValue& a1, const AddressValue& a2)
+{
+   return !(a2 < a1);
+}
+
+inline AddressValue operator&(const AddressValue& a1, const AddressValue& a2)
+{
+   return AddressValue { a1.high & a2.high, a1.low & a2.low };
+}
+
+inline AddressValue operator|(const AddressValue& a1, const AddressValue& a2)
+{
+   return AddressValue { a1.high | a2.high, a1.low | a2.low };
+}
+
+struct AddressValueHash {
+   size_t operator()(const AddressValue& value) const {
+      const uint64_t h = (value.high * 0x9e3779b97f4a7c15ULL) ^ value.low;
+      return (size_t)((h ^ (h >> 31)) * 0xbf58476d1ce4e5b9ULL);
+   }
+};
+
+inline AddressValue increment(const AddressValue& a)
+{
+   return AddressValue { a.high + ((a.low == ~0ULL) ? 1 : 0), a.low + 1 };
+}
+
+inline AddressValue decrement(const AddressValue& a)
+{
+   return AddressValue { a.high - ((a.low == 0) ? 1 : 0), a.low - 1 };
+}
+
+inline AddressValue subtract(const AddressValue& a1, const AddressValue& a2)
+{
+   return AddressValue { a1.high - a2.high - ((a1.low < a2.low) ? 1 : 0),
+                         a1.low - a2.low };
+}
+
+
+// ###### Prefix (normalised network address and prefix length) #############
+struct Prefix {
+   AddressValue network;
+   uint8_t      family;    // AF_INET or AF_INET6
+   uint8_t      length;    // Prefix length
+   uint32_t     source;    // Index of the list the prefix has been read from
+};
+
+inline unsigned int familyBits(const unsigned int family)
+{
+   return (family == AF_INET) ? 32 : 128;
+}
+
+// ###### Masks of a prefix, specialised per address family #################
+// Bulk kernels working on addresses of one family use these variants, so
+// that there is no family check per address. Like the addresses, IPv4
+// masks are stored in the lower 32 bits of "low".
+template<unsigned int Family>
+inline AddressValue hostMask(const unsigned int length)
+{
+   static_assert((Family == AF_INET) || (Family == AF_INET6), "Invalid family");
+   if constexpr(Family == AF_INET) {
+      return AddressValue { 0, 0xffffffffULL >> length };
+   }
+   else {
+      return AddressValue { (length < 64)  ? (~0ULL >> length) : 0,
+                            (length <= 64) ? ~0ULL :
+                               ((length < 128) ? (~0ULL >> (length - 64)) : 0) };
+   }
+}
+
+template<unsigned int Family>
+inline AddressValue netMask(const unsigned int length)
+{
+   const AddressValue h = hostMask<Family>(length);
+   if constexpr(Family == AF_INET) {
+      return AddressValue { 0, ~h.low & 0xffffffffULL };
+   }
+   else {
+      return AddressValue { ~h.high, ~h.low };
+   }
+}
+
+// Returns the prefix length of a netmask, or -1 if it is not contiguous.
+template<unsigned int Family>
+inline int maskLength(const AddressValue& mask)
+{
+   // The host bits have to be of the form 0...01...1:
+   const AddressValue h = AddressValue { ~mask.high, ~mask.low } & hostMask<Family>(0);
+   const AddressValue c = h & increment(h);
+   if((c.high | c.low) != 0) {
+      return -1;
+   }
+   return (int)(familyBits(Family) -
+                __builtin_popcountll(h.high) - __builtin_popcountll(h.low));
+}
+
+
+// ###### Masks of a prefix #################################################
+inline AddressValue hostMask(const unsigned int family, const unsigned int length)
+{
+   assert(length <= familyBits(family));
+   return (family == AF_INET) ? hostMask<AF_INET>(length) : hostMask<AF_INET6>(length);
+}
+
+inline AddressValue netMask(const unsigned int family, const unsigned int length)
+{
+   assert(length <= familyBits(family));
+   return (family == AF_INET) ? netMask<AF_INET>(length) : netMask<AF_INET6>(length);
+}
+
+inline int maskLength(const unsigned int family, const AddressValue& mask)
+{
+   return (family == AF_INET) ? maskLength<AF_INET>(mask) : maskLength<AF_INET6>(mask);
+}
+
+inline AddressValue lastAddress(const Prefix& prefix)
+{
+   return prefix.network | hostMask(prefix.family, prefix.length);
+}
+
+// ###### Number of addresses of a prefix not usable for hosts ##############
+// Like the host range calculation: network and broadcast address for IPv4
+// (except for /31 and /32), the Subnet-Router anycast address for IPv6
+// (except for /128).
+inline unsigned int reservedHosts(const Prefix& prefix)
+{
+   if(prefix.family == AF_INET) {
+      return (prefix.length < 31) ? 2 : 0;
+   }
+   return (prefix.length < 128) ? 1 : 0;
+}
+
+inline bool isReservedHost(const Prefix& prefix, const AddressValue& address)
+{
+   return (reservedHosts(prefix) > 0) &&
+          ( (address == prefix.network) ||
+            ((prefix.family == AF_INET) && (address == lastAddress(prefix))) );
+}
+
+inline bool operator<(const Prefix& p1, const Prefix& p2)
+{
+   if(p1.family != p2.family) {
+      return p1.family < p2.family;
+   }
+   if(p1.network != p2.network) {
+      return p1.network < p2.network;
+   }
+   return p1.length < p2.length;
+}
+
+inline bool operator==(const Prefix& p1, const Prefix& p2)
+{
+   return (p1.family == p2.family) && (p1.network == p2.network) &&
+          (p1.length == p2.length);
+}
+
+// ###### Check whether prefix p1 contains (or equals) prefix p2 ############
+inline bool containsPrefix(const Prefix& p1, const Prefix& p2)
+{
+   return (p1.family == p2.family) && (p1.length <= p2.length) &&
+          ((p2.network & netMask(p1.family, p1.length)) == p1.network);
+}
+
+void addressToValue(const sockaddr_union& address, AddressValue& value);
+void valueToAddress(const unsigned int  family,
+                    const AddressValue& value,
+                    sockaddr_union&     address);
+void makePrefix(const sockaddr_union& network,
+                const unsigned int    length,
+                Prefix&               prefix);
+
+bool parseIPv4Address(const char* string, const size_t length, AddressValue& value);
+bool parseIPv6Address(const char* string, const size_t length, AddressValue& value);
+bool parseAddressPrefix(const char*   string,
+                        AddressValue& address,
+                        unsigned int& family,
+                        unsigned int& length);
+bool parsePrefix(const char* string, Prefix& prefix);
+
+// ###### Sequential reader of a prefix list ("-" for standard input) #######
+class PrefixListReader
+{
+   public:
+   PrefixListReader(const char* fileName, const uint32_t source = 0);
+
+   // Returns false at the end of the list, or on error (see failed()).
+   bool next(Prefix& prefix);
+   inline bool failed() const { return Failed; }
+   inline unsigned int lineNumber() const { return LineNumber; }
+
+   private:
+   const char*         FileName;
+   const uint32_t      Source;
+   std::ifstream       FileStream;
+   std::istream*       IS;
+   std::string         Line;
+   unsigned int        LineNumber;
+   std::vector<Prefix> RangePrefixes;
+   size_t              RangeIndex;
+   bool                Failed;
+};
+
+typedef std::function<void(const Prefix& prefix)> PrefixHandler;
+bool forEachPrefix(const char*          fileName,
+                   const PrefixHandler& handler,
+                   const uint32_t       source = 0);
+bool readPrefixList(const char*          fileName,
+                    std::vector<Prefix>& prefixList,
+                    const uint32_t       source = 0);
+bool readAddressList(const char*          fileName,
+                     std::vector<Prefix>& addressList);
+const char* parseListArgument(const char* argument, std::string& label);
+void sortPrefixList(std::vector<Prefix>& prefixList);
+
+void rangeToPrefixes(const unsigned int   family,
+                     AddressValue         first,
+                     const AddressValue&  last,
+                     std::vector<Prefix>& prefixList);
+
+std::string addressValueToString(const unsigned int  family,
+                                 const AddressValue& value);
+std::string prefixToString(const Prefix& prefix);
+
+#endif
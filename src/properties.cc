@@ -0,0 +1,161 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "properties.h"
+
+
+// ###### Get properties of given address ###################################
+unsigned int getAddressProperties(const sockaddr_union& address)
+{
+   unsigned int properties = 0;
+
+   // ====== IPv4 properties ================================================
+   if(address.sa.sa_family == AF_INET) {
+      const in_addr_t    ipv4address = ntohl(address.in.sin_addr.s_addr);
+      const unsigned int a           = ipv4address >> 24;
+      const unsigned int b           = (ipv4address & 0x00ff0000) >> 16;
+
+      if(IN_CLASSA(ipv4address)) {
+         properties |= AP_ClassA;
+         if(ipv4address == INADDR_LOOPBACK) {
+            properties |= AP_Loopback;
+         }
+         else if(a == IN_LOOPBACKNET) {
+            properties |= AP_LoopbackNetwork;
+         }
+         else if(a == 10) {
+            properties |= AP_Private;
+         }
+      }
+      else if(IN_CLASSB(ipv4address)) {
+         properties |= AP_ClassB;
+         if((a == 172) && ((b >= 16) && (b <= 31))) {
+            properties |= AP_Private;
+         }
+         else if((a == 169) && (b == 254)) {
+            properties |= AP_LinkLocal;
+         }
+      }
+      else if(IN_CLASSC(ipv4address)) {
+         properties |= AP_ClassC;
+         if((a == 192) && (b == 168)) {
+            properties |= AP_Private;
+         }
+      }
+      else if(IN_CLASSD(ipv4address)) {
+         properties |= AP_ClassD | AP_Multicast;
+         if(a == 232) {
+            properties |= AP_SourceSpecific;
+         }
+      }
+      else {
+         properties |= AP_InvalidClass;
+      }
+   }
+
+   // ====== IPv6 properties ================================================
+   else if(address.sa.sa_family == AF_INET6) {
+      const in6_addr& ipv6address = address.in6.sin6_addr;
+      const uint16_t  word0       = (ipv6address.s6_addr[0] << 8) | ipv6address.s6_addr[1];
+      const uint16_t  word1       = (ipv6address.s6_addr[2] << 8) | ipv6address.s6_addr[3];
+      const uint16_t  word5       = (ipv6address.s6_addr[10] << 8) | ipv6address.s6_addr[11];
+      const uint16_t  word6       = (ipv6address.s6_addr[12] << 8) | ipv6address.s6_addr[13];
+
+      if(IN6_IS_ADDR_LOOPBACK(&ipv6address)) {
+         properties |= AP_Loopback;
+      }
+      else if(IN6_IS_ADDR_UNSPECIFIED(&ipv6address)) {
+         properties |= AP_Unspecified;
+      }
+      else if(IN6_IS_ADDR_V4COMPAT(&ipv6address)) {
+         properties |= AP_IPv4Compatible;
+      }
+      else if(IN6_IS_ADDR_V4MAPPED(&ipv6address)) {
+         properties |= AP_IPv4Mapped;
+      }
+      else if(hasTranslationPrefix(&address.in6)) {
+         properties |= AP_IPv4Embedded;
+      }
+      else if(IN6_IS_ADDR_MULTICAST(&ipv6address)) {
+         properties |= AP_Multicast;
+         if( ((word0 & 0xfff0) == 0xff30) && (word1 == 0x0000) ) {
+            // FF0x:0::/32
+            properties |= AP_SourceSpecific;
+         }
+         if( (word0 == 0xff02) &&
+             (word5 == 0x0001) &&
+             ((word6 & 0xff00) == 0xff00) ) {
+            // FF02::1:FF00:0/104
+            properties |= AP_SolicitedNode;
+         }
+      }
+      else if(IN6_IS_ADDR_LINKLOCAL(&ipv6address)) {
+         properties |= AP_LinkLocal;
+      }
+      else if(IN6_IS_ADDR_SITELOCAL(&ipv6address)) {
+         properties |= AP_SiteLocal;
+      }
+      else if((word0 & 0xfc00) == 0xfc00) {
+         properties |= AP_UniqueLocal;
+      }
+      else if((word0 & 0xe000) == 0x2000) {
+         properties |= AP_GlobalUnicast;
+         if((word0 & 0x2002) == 0x2002) {
+            properties |= AP_6to4;
+         }
+      }
+   }
+
+   return properties;
+}
+
+
+// ###### Convert properties to comma-separated list ########################
+std::string propertiesToString(const unsigned int properties)
+{
+   static const char* const propertyNames[] = {
+      "class-a", "class-b", "class-c", "class-d", "invalid-class",
+      "loopback", "loopback-network", "private", "link-local", "multicast",
+      "source-specific", "solicited-node", "unspecified", "ipv4-compatible",
+      "ipv4-mapped", "ipv4-embedded", "site-local", "unique-local",
+      "global-unicast", "6to4"
+   };
+
+   std::string result;
+   for(unsigned int i = 0; i < sizeof(propertyNames) / sizeof(propertyNames[0]); i++) {
+      if(properties & (1U << i)) {
+         if(!result.empty()) {
+            result += ",";
+         }
+         result += propertyNames[i];
+      }
+   }
+   return result;
+}
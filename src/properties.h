@@ -0,0 +1,69 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef PROPERTIES_H
+#define PROPERTIES_H
+
+#include <string>
+
+#include "tools.h"
+
+
+// ###### Address properties ################################################
+enum AddressProperty {
+   // ====== IPv4 address classes ===========================================
+   AP_ClassA          = (1 << 0),
+   AP_ClassB          = (1 << 1),
+   AP_ClassC          = (1 << 2),
+   AP_ClassD          = (1 << 3),
+   AP_InvalidClass    = (1 << 4),
+
+   // ====== Special-purpose addresses ======================================
+   AP_Loopback        = (1 << 5),
+   AP_LoopbackNetwork = (1 << 6),
+   AP_Private         = (1 << 7),
+   AP_LinkLocal       = (1 << 8),
+   AP_Multicast       = (1 << 9),
+   AP_SourceSpecific  = (1 << 10),
+   AP_SolicitedNode   = (1 << 11),
+   AP_Unspecified     = (1 << 12),
+   AP_IPv4Compatible  = (1 << 13),
+   AP_IPv4Mapped      = (1 << 14),
+   AP_IPv4Embedded    = (1 << 15),
+   AP_SiteLocal       = (1 << 16),
+   AP_UniqueLocal     = (1 << 17),
+   AP_GlobalUnicast   = (1 << 18),
+   AP_6to4            = (1 << 19)
+};
+
+unsigned int getAddressProperties(const sockaddr_union& address);
+std::string propertiesToString(const unsigned int properties);
+
+#endif
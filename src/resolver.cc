@@ -0,0 +1,730 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "resolver.h"
+#include "prefixlist.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <netdb.h>
+#include <poll.h>
+#include <random>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+#ifndef AI_IDN
+#include <idn2.h>
+#endif
+
+
+static const unsigned int       MaxQueriesInFlight = 256;
+static const unsigned long long QueryTimeout       = 1000000;   // in us, doubled on each retry
+static const unsigned int       MaxAttempts        = 3;
+
+static const uint16_t DNSTypeA        = 1;
+static const uint16_t DNSTypeAAAA     = 28;
+static const uint16_t DNSTypeOPT      = 41;
+static const uint16_t DNSClassIN      = 1;
+static const uint16_t EDNSPayloadSize = 4096;   // Size of the UDP receive buffer
+
+// Result of a name's A or AAAA query
+enum QueryStatus {
+   QS_Pending   = -1,
+   QS_Timeout   = -2,
+   QS_Invalid   = -3,
+   QS_Truncated = -4,   // Truncated response, to be repeated over TCP
+   QS_NoError   = 0,    // Otherwise: the RCODE of the response
+   QS_ServFail  = 2,
+   QS_NXDomain  = 3
+};
+
+
+// ====== Name to be resolved ===============================================
+struct NameState {
+   std::string         Name;        // Normalised: lower case, without final "."
+   int                 Status[2];   // A and AAAA (QueryStatus or RCODE)
+   std::vector<Prefix> Addresses;
+};
+
+// ====== Query in flight ===================================================
+struct PendingQuery {
+   uint32_t           Name;
+   unsigned int       TypeIndex;   // 0 for A, 1 for AAAA
+   uint16_t           ID;
+   unsigned int       Attempts;
+   unsigned long long Deadline;
+};
+
+
+// ###### Parse name server address ("address" or "address:port") ###########
+bool parseNameServer(const char* string, sockaddr_union& nameServer)
+{
+   if(!string2address(string, &nameServer, true)) {
+      return false;
+   }
+   if(nameServer.sa.sa_family == AF_INET) {
+      if(nameServer.in.sin_port == 0) {
+         nameServer.in.sin_port = htons(53);
+      }
+   }
+   else if(nameServer.in6.sin6_port == 0) {
+      nameServer.in6.sin6_port = htons(53);
+   }
+   return true;
+}
+
+
+// ###### Get first name server of the system configuration #################
+// Like the resolver library, 127.0.0.1 is used if there is none.
+bool getSystemNameServer(sockaddr_union& nameServer)
+{
+   std::ifstream is("/etc/resolv.conf");
+   std::string   line;
+   while(std::getline(is, line)) {
+      char address[128];
+      if( (sscanf(line.c_str(), " nameserver %127s", address) == 1) &&
+          (string2address(address, &nameServer, false)) ) {
+         return parseNameServer(address, nameServer);
+      }
+   }
+   return parseNameServer("127.0.0.1", nameServer);
+}
+
+
+// ###### Normalise host name ###############################################
+// Non-ASCII names are converted to their A-labels (IDNA 2008). Returns
+// false for names which cannot be encoded in a DNS query.
+static bool normaliseName(const std::string& input, std::string& name)
+{
+   name = input;
+   if(std::any_of(name.begin(), name.end(),
+                  [](const char c) { return (c & 0x80) != 0; })) {
+#ifdef AI_IDN
+      return false;   // To be resolved by getaddrinfo() with AI_IDN
+#else
+      initialiseI18N();   // IDN conversion depends on the locale's charset
+      char* punycode = nullptr;
+      if(idn2_to_ascii_8z(name.c_str(), &punycode, 0) != IDN2_OK) {
+         return false;
+      }
+      name = punycode;
+      free(punycode);
+#endif
+   }
+   if( (!name.empty()) && (name.back() == '.') ) {
+      name.pop_back();
+   }
+   if( (name.empty()) || (name.size() > 253) ) {
+      return false;
+   }
+   size_t labelLength = 0;
+   for(char& c : name) {
+      if(c == '.') {
+         if(labelLength == 0) {
+            return false;
+         }
+         labelLength = 0;
+      }
+      else if( (++labelLength > 63) || (c < 0x21) || (c > 0x7e) ) {
+         return false;
+      }
+      c = (char)tolower((unsigned char)c);
+   }
+   return (labelLength > 0);
+}
+
+
+// ###### Build DNS query ###################################################
+static size_t buildQuery(uint8_t*           packet,
+                         const uint16_t     id,
+                         const std::string& name,
+                         const uint16_t     type)
+{
+   // ====== Header: ID, flags (RD), 1 question, 1 additional record =======
+   const uint8_t header[12] = { (uint8_t)(id >> 8), (uint8_t)(id & 0xff),
+                                0x01, 0x00, 0x00, 0x01, 0, 0, 0, 0, 0, 1 };
+   memcpy(packet, header, sizeof(header));
+   size_t pos = sizeof(header);
+
+   // ====== Question =======================================================
+   size_t begin = 0;
+   while(begin <= name.size()) {
+      size_t end = name.find('.', begin);
+      if(end == std::string::npos) {
+         end = name.size();
+      }
+      packet[pos++] = (uint8_t)(end - begin);
+      memcpy(&packet[pos], name.data() + begin, end - begin);
+      pos += end - begin;
+      begin = end + 1;
+   }
+   packet[pos++] = 0x00;
+   packet[pos++] = (uint8_t)(type >> 8);
+   packet[pos++] = (uint8_t)(type & 0xff);
+   packet[pos++] = (uint8_t)(DNSClassIN >> 8);
+   packet[pos++] = (uint8_t)(DNSClassIN & 0xff);
+
+   // ====== EDNS0 OPT record (RFC 6891): root name, UDP payload size =======
+   const uint8_t opt[11] = { 0x00, (uint8_t)(DNSTypeOPT >> 8), (uint8_t)(DNSTypeOPT & 0xff),
+                             (uint8_t)(EDNSPayloadSize >> 8), (uint8_t)(EDNSPayloadSize & 0xff),
+                             0, 0, 0, 0, 0, 0 };
+   memcpy(&packet[pos], opt, sizeof(opt));
+   pos += sizeof(opt);
+   return pos;
+}
+
+
+// ###### Read (possibly compressed) name of a DNS message ##################
+// The name is converted to lower case. "pos" is moved behind the name.
+static bool readName(const uint8_t* packet,
+                     const size_t   size,
+                     size_t&        pos,
+                     std::string&   name)
+{
+   name.clear();
+   size_t       p        = pos;
+   bool         jumped   = false;
+   unsigned int pointers = 0;
+   while(p < size) {
+      const uint8_t length = packet[p];
+      if(length == 0) {
+         if(!jumped) {
+            pos = p + 1;
+         }
+         return true;
+      }
+      if((length & 0xc0) == 0xc0) {
+         if( (p + 1 >= size) || (++pointers > 64) ) {
+            return false;
+         }
+         if(!jumped) {
+            pos = p + 2;
+            jumped = true;
+         }
+         p = ((size_t)(length & 0x3f) << 8) | packet[p + 1];
+         continue;
+      }
+      if( ((length & 0xc0) != 0) || (p + 1 + length > size) ) {
+         return false;
+      }
+      if(!name.empty()) {
+         name += '.';
+      }
+      for(size_t i = 1; i <= length; i++) {
+         name += (char)tolower(packet[p + i]);
+      }
+      p += 1 + length;
+   }
+   return false;
+}
+
+
+// ###### Get 16-bit value of a DNS message #################################
+static inline uint16_t get16(const uint8_t* data)
+{
+   return (uint16_t)((data[0] << 8) | data[1]);
+}
+
+
+// ###### Handle DNS response ###############################################
+// The response has to match a query in flight, by ID and question. All A
+// and AAAA records of the answer section are used, i.e. also the ones of
+// the targets of a CNAME chain. The addresses of a truncated response are
+// used as well, but its query is marked as QS_Truncated, to be repeated
+// over TCP. Returns the query's index, or -1.
+static int handleResponse(const uint8_t*              packet,
+                          const size_t                size,
+                          std::vector<PendingQuery>&  pending,
+                          std::vector<NameState>&     names)
+{
+   if( (size < 12) || ((packet[2] & 0x80) == 0) || (get16(&packet[4]) != 1) ) {
+      return -1;
+   }
+   const uint16_t id = get16(&packet[0]);
+   const auto     query = std::find_if(pending.begin(), pending.end(),
+                                       [id](const PendingQuery& q) { return q.ID == id; });
+   if(query == pending.end()) {
+      return -1;
+   }
+   NameState&     state = names[query->Name];
+   const uint16_t type  = (query->TypeIndex == 0) ? DNSTypeA : DNSTypeAAAA;
+
+   // ====== Check question =================================================
+   size_t      pos = 12;
+   std::string name;
+   if( (!readName(packet, size, pos, name)) || (pos + 4 > size) ||
+       (name != state.Name) || (get16(&packet[pos]) != type) ) {
+      return -1;
+   }
+   pos += 4;
+
+   // ====== Get addresses of the answer section ============================
+   const unsigned int rcode   = packet[3] & 0x0f;
+   const unsigned int answers = get16(&packet[6]);
+   for(unsigned int i = 0; i < answers; i++) {
+      if( (!readName(packet, size, pos, name)) || (pos + 10 > size) ) {
+         break;
+      }
+      const uint16_t rrType   = get16(&packet[pos]);
+      const uint16_t rrClass  = get16(&packet[pos + 2]);
+      const uint16_t rdLength = get16(&packet[pos + 8]);
+      pos += 10;
+      if(pos + rdLength > size) {
+         break;
+      }
+      if( (rrClass == DNSClassIN) && (rrType == type) ) {
+         Prefix address;
+         if( (rrType == DNSTypeA) && (rdLength == 4) ) {
+            address = Prefix { { 0, get16(&packet[pos]) * 0x10000ULL + get16(&packet[pos + 2]) },
+                               AF_INET, 32, 0 };
+            state.Addresses.push_back(address);
+         }
+         else if( (rrType == DNSTypeAAAA) && (rdLength == 16) ) {
+            address = Prefix { { 0, 0 }, AF_INET6, 128, 0 };
+            for(unsigned int j = 0; j < 8; j++) {
+               address.network.high = (address.network.high << 8) | packet[pos + j];
+               address.network.low  = (address.network.low << 8)  | packet[pos + 8 + j];
+            }
+            state.Addresses.push_back(address);
+         }
+      }
+      pos += rdLength;
+   }
+   state.Status[query->TypeIndex] = (packet[2] & 0x02) ? QS_Truncated : (int)rcode;
+   return (int)(query - pending.begin());
+}
+
+
+// ###### Resolve names with the name server ################################
+// The A and AAAA queries of all names are sent over one UDP socket, with up
+// to MaxQueriesInFlight queries at the same time. Lost queries are
+// repeated, with exponential backoff starting at QueryTimeout. The queries
+// of truncated responses are marked as QS_Truncated, and are repeated over
+// TCP afterwards.
+static bool resolveNamesOverUDP(const sockaddr_union&   nameServer,
+                         std::vector<NameState>& names)
+{
+   const int sd = socket(nameServer.sa.sa_family, SOCK_DGRAM, 0);
+   if(sd < 0) {
+      std::cerr << format(gettext("ERROR: Unable to create socket: %s!"), strerror(errno)) << "\n";
+      return false;
+   }
+   // Only responses of the name server are received on a connected socket.
+   if(connect(sd, &nameServer.sa, getSocklen(&nameServer.sa)) != 0) {
+      char nameServerString[128];
+      address2string(&nameServer.sa, nameServerString, sizeof(nameServerString), true);
+      std::cerr << format(gettext("ERROR: Unable to connect to %s: %s!"),
+                          nameServerString, strerror(errno)) << "\n";
+      close(sd);
+      return false;
+   }
+   fcntl(sd, F_SETFL, fcntl(sd, F_GETFL, 0) | O_NONBLOCK);
+
+   // ====== Query IDs ======================================================
+   // Random IDs make spoofed responses harder.
+   // Released IDs are appended, so that they are reused last.
+   std::vector<uint16_t> ids(65536);
+   for(unsigned int i = 0; i < 65536; i++) {
+      ids[i] = (uint16_t)i;
+   }
+   std::shuffle(ids.begin(), ids.end(), std::mt19937(std::random_device()()));
+   std::deque<uint16_t> freeIDs(ids.begin(), ids.end());
+
+   std::vector<PendingQuery> pending;
+   uint8_t                   packet[EDNSPayloadSize];
+   size_t                    next = 0;   // Next query: name = next / 2, type = next % 2
+   auto send = [&](const PendingQuery& query) {
+      const size_t length = buildQuery(packet, query.ID, names[query.Name].Name,
+                                       (query.TypeIndex == 0) ? DNSTypeA : DNSTypeAAAA);
+      // A failed transmission is handled like a lost query.
+      (void)::send(sd, packet, length, 0);
+   };
+
+   while( (next < 2 * names.size()) || (!pending.empty()) ) {
+      // ====== Send new queries ============================================
+      const unsigned long long now = getMicroTime();
+      while( (next < 2 * names.size()) && (pending.size() < MaxQueriesInFlight) ) {
+         const uint32_t name = (uint32_t)(next / 2);
+         if(names[name].Status[next % 2] == QS_Pending) {
+            pending.push_back(PendingQuery { name, (unsigned int)(next % 2), freeIDs.front(),
+                                             1, now + QueryTimeout });
+            freeIDs.pop_front();
+            send(pending.back());
+         }
+         next++;
+      }
+
+      // ====== Repeat or give up timed-out queries =========================
+      unsigned long long deadline = now + (QueryTimeout << MaxAttempts);
+      for(size_t i = 0; i < pending.size(); ) {
+         PendingQuery& query = pending[i];
+         if(query.Deadline <= now) {
+            if(query.Attempts >= MaxAttempts) {
+               names[query.Name].Status[query.TypeIndex] = QS_Timeout;
+               freeIDs.push_back(query.ID);
+               pending[i] = pending.back();
+               pending.pop_back();
+               continue;
+            }
+            query.Deadline = now + (QueryTimeout << query.Attempts);
+            query.Attempts++;
+            send(query);
+         }
+         deadline = std::min(deadline, query.Deadline);
+         i++;
+      }
+      if(pending.empty()) {
+         continue;
+      }
+
+      // ====== Receive responses ===========================================
+      pollfd pfd;
+      pfd.fd     = sd;
+      pfd.events = POLLIN;
+      const int timeout = (int)((deadline - now + 999) / 1000);
+      if(poll(&pfd, 1, timeout) > 0) {
+         ssize_t received;
+         while( (received = recv(sd, packet, sizeof(packet), 0)) >= 0 ) {
+            const int index = handleResponse(packet, (size_t)received, pending, names);
+            if(index >= 0) {
+               freeIDs.push_back(pending[index].ID);
+               pending[index] = pending.back();
+               pending.pop_back();
+            }
+         }
+      }
+   }
+   close(sd);
+   return true;
+}
+
+
+// ###### Wait for socket event until deadline ##############################
+static bool waitForSocket(const int                sd,
+                          const short              events,
+                          const unsigned long long deadline)
+{
+   const unsigned long long now = getMicroTime();
+   if(now >= deadline) {
+      return false;
+   }
+   pollfd pfd;
+   pfd.fd     = sd;
+   pfd.events = events;
+   return (poll(&pfd, 1, (int)((deadline - now + 999) / 1000)) > 0);
+}
+
+
+// ###### Repeat query over TCP #############################################
+// One connection is used per query, with a timeout of all UDP attempts
+// together. If the query fails, it stays QS_Truncated, so that the
+// addresses of the truncated response are reported as incomplete.
+static void resolveNameOverTCP(const sockaddr_union&   nameServer,
+                               const PendingQuery&     query,
+                               std::vector<NameState>& names)
+{
+   const int sd = socket(nameServer.sa.sa_family, SOCK_STREAM, 0);
+   if(sd < 0) {
+      return;
+   }
+   fcntl(sd, F_SETFL, fcntl(sd, F_GETFL, 0) | O_NONBLOCK);
+   const unsigned long long deadline = getMicroTime() + (QueryTimeout << MaxAttempts);
+
+   // ====== Connect ========================================================
+   if(connect(sd, &nameServer.sa, getSocklen(&nameServer.sa)) != 0) {
+      int       error  = 0;
+      socklen_t length = sizeof(error);
+      if( (errno != EINPROGRESS) || (!waitForSocket(sd, POLLOUT, deadline)) ||
+          (getsockopt(sd, SOL_SOCKET, SO_ERROR, &error, &length) != 0) || (error != 0) ) {
+         close(sd);
+         return;
+      }
+   }
+
+   // ====== Send query with 2-byte length prefix ===========================
+   std::vector<uint8_t> packet(2 + 65535);
+   const size_t querySize = buildQuery(&packet[2], query.ID, names[query.Name].Name,
+                                       (query.TypeIndex == 0) ? DNSTypeA : DNSTypeAAAA);
+   packet[0] = (uint8_t)(querySize >> 8);
+   packet[1] = (uint8_t)(querySize & 0xff);
+   size_t done = 0;
+   while(done < 2 + querySize) {
+      const ssize_t sent = ::send(sd, &packet[done], 2 + querySize - done, MSG_NOSIGNAL);
+      if(sent > 0) {
+         done += (size_t)sent;
+      }
+      else if( ((sent < 0) && (errno != EAGAIN) && (errno != EINTR)) ||
+               (!waitForSocket(sd, POLLOUT, deadline)) ) {
+         close(sd);
+         return;
+      }
+   }
+
+   // ====== Receive response with 2-byte length prefix =====================
+   size_t size = 2;
+   done = 0;
+   while(done < size) {
+      const ssize_t received = recv(sd, &packet[done], size - done, 0);
+      if(received > 0) {
+         done += (size_t)received;
+         if( (done == 2) && (size == 2) ) {
+            size = 2 + get16(&packet[0]);
+         }
+      }
+      else if( (received == 0) ||
+               ((errno != EAGAIN) && (errno != EINTR)) ||
+               (!waitForSocket(sd, POLLIN, deadline)) ) {
+         close(sd);
+         return;
+      }
+   }
+   close(sd);
+   std::vector<PendingQuery> pending { query };
+   handleResponse(&packet[2], size - 2, pending, names);
+}
+
+
+// ###### Resolve names with the name server ################################
+// The names are resolved over UDP. Queries with truncated responses are
+// repeated over TCP.
+static bool resolveNames(const sockaddr_union&   nameServer,
+                         std::vector<NameState>& names)
+{
+   if(!resolveNamesOverUDP(nameServer, names)) {
+      return false;
+   }
+   for(uint32_t name = 0; name < names.size(); name++) {
+      for(unsigned int typeIndex = 0; typeIndex < 2; typeIndex++) {
+         if(names[name].Status[typeIndex] == QS_Truncated) {
+            resolveNameOverTCP(nameServer,
+                               PendingQuery { name, typeIndex,
+                                              (uint16_t)std::random_device()(), 1, 0 },
+                               names);
+         }
+      }
+   }
+   return true;
+}
+
+
+// ###### Resolve name with getaddrinfo() ###################################
+// Used for names which cannot be converted into a DNS query here, i.e.
+// names needing the IDN conversion of getaddrinfo(), for single-label names,
+// and for names not found by the name server. So, the search domains of
+// resolv.conf, /etc/hosts and the other sources of nsswitch.conf apply to
+// them. All A and AAAA results are used.
+static void resolveNameWithSystem(const std::string& input, NameState& state)
+{
+   addrinfo  hints;
+   addrinfo* result = nullptr;
+   memset(&hints, 0, sizeof(hints));
+   hints.ai_family   = AF_UNSPEC;
+   hints.ai_socktype = SOCK_DGRAM;
+#ifdef AI_IDN
+   hints.ai_flags    = AI_IDN;
+   initialiseI18N();   // IDN conversion depends on the locale's charset
+#endif
+   const int error = getaddrinfo(input.c_str(), nullptr, &hints, &result);
+   if(error != 0) {
+      state.Status[0] = state.Status[1] = (error == EAI_NONAME) ? QS_NXDomain : QS_ServFail;
+      return;
+   }
+   for(const addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+      if( (ai->ai_family == AF_INET) || (ai->ai_family == AF_INET6) ) {
+         sockaddr_union address;
+         memset(&address, 0, sizeof(address));
+         memcpy(&address, ai->ai_addr, std::min((size_t)ai->ai_addrlen, sizeof(address)));
+         Prefix prefix;
+         makePrefix(address, familyBits(ai->ai_family), prefix);
+         state.Addresses.push_back(prefix);
+      }
+   }
+   freeaddrinfo(result);
+   state.Status[0] = state.Status[1] = QS_NoError;
+}
+
+
+// ###### Get status of a resolved name #####################################
+static const char* nameStatus(const NameState& state)
+{
+   const bool answered = (state.Status[0] >= QS_NoError) && (state.Status[1] >= QS_NoError);
+   if(!state.Addresses.empty()) {
+      return ((answered) && (state.Status[0] != QS_ServFail) && (state.Status[1] != QS_ServFail)) ?
+                "ok" : "incomplete";
+   }
+   if( (state.Status[0] == QS_NXDomain) || (state.Status[1] == QS_NXDomain) ) {
+      return "nxdomain";
+   }
+   if( (state.Status[0] == QS_NoError) && (state.Status[1] == QS_NoError) ) {
+      return "noaddress";
+   }
+   if( (state.Status[0] == QS_Timeout) || (state.Status[1] == QS_Timeout) ) {
+      return "timeout";
+   }
+   if(state.Status[0] == QS_Invalid) {
+      return "invalid";
+   }
+   return "error";
+}
+
+
+// ###### Resolve list of host names and print addresses and networks #######
+// Each name is resolved once, even if it occurs several times in the list:
+// the results are cached for the whole list. Numeric addresses in the list
+// are not resolved. For each address, the containing network of the given
+// prefix length is printed.
+bool printResolvedNames(std::ostream&         os,
+                        const OutputFormat    outputFormat,
+                        const char*           nameListFileName,
+                        const sockaddr_union& nameServer,
+                        const unsigned int    ipv4PrefixLength,
+                        const unsigned int    ipv6PrefixLength)
+{
+   std::ifstream fileStream;
+   std::istream* is = &std::cin;
+   if(strcmp(nameListFileName, "-") != 0) {
+      fileStream.open(nameListFileName);
+      if(!fileStream) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), nameListFileName) << "\n";
+         return false;
+      }
+      is = &fileStream;
+   }
+
+   // ====== Read names =====================================================
+   std::vector<std::string>                  inputs;
+   std::vector<uint32_t>                     inputNames;
+   std::vector<NameState>                    names;
+   std::unordered_map<std::string, uint32_t> nameIndex;
+   std::vector<std::pair<uint32_t, size_t>>  systemNames;
+   std::string                               line;
+   std::string                               name;
+   while(std::getline(*is, line)) {
+      const size_t begin = line.find_first_not_of(" \t\r");
+      if( (begin == std::string::npos) || (line[begin] == '#') ) {
+         continue;
+      }
+      const size_t end = line.find_first_of(" \t\r,#", begin);
+      inputs.push_back(line.substr(begin, (end == std::string::npos) ? std::string::npos : end - begin));
+      const std::string& input = inputs.back();
+
+      NameState    state;
+      AddressValue address;
+      unsigned int family;
+      unsigned int length;
+      bool         systemResolution = false;
+      state.Status[0] = state.Status[1] = QS_Pending;
+      if(parseAddressPrefix(input.c_str(), address, family, length)) {
+         name = input;   // Numeric address
+         state.Status[0] = state.Status[1] = QS_NoError;
+         state.Addresses.push_back(Prefix { address, (uint8_t)family,
+                                            (uint8_t)familyBits(family), 0 });
+      }
+      else if(normaliseName(input, name)) {
+         // Single-label names are resolved with the search domains
+         systemResolution = (name.find('.') == std::string::npos) && (input.back() != '.');
+      }
+      else {
+         name = input;
+         state.Status[0] = state.Status[1] = QS_Invalid;
+#ifdef AI_IDN
+         if(std::any_of(input.begin(), input.end(),
+                        [](const char c) { return (c & 0x80) != 0; })) {
+            state.Status[0] = state.Status[1] = QS_Pending;
+            systemResolution = true;
+         }
+#endif
+      }
+      state.Name = name;
+      const auto found = nameIndex.insert(std::make_pair(name, (uint32_t)names.size()));
+      if(found.second) {
+         if(systemResolution) {
+            systemNames.push_back(std::make_pair((uint32_t)names.size(), inputs.size() - 1));
+         }
+         names.push_back(state);
+      }
+      inputNames.push_back(found.first->second);
+   }
+
+   // ====== Resolve names ==================================================
+   std::vector<bool> resolvedBySystem(names.size(), false);
+   for(const std::pair<uint32_t, size_t>& systemName : systemNames) {
+      resolveNameWithSystem(inputs[systemName.second], names[systemName.first]);
+      resolvedBySystem[systemName.first] = true;
+   }
+   if(!resolveNames(nameServer, names)) {
+      return false;
+   }
+   for(uint32_t i = 0; i < names.size(); i++) {
+      // Names not found by the name server may be in /etc/hosts, etc.
+      if( (!resolvedBySystem[i]) && (strcmp(nameStatus(names[i]), "nxdomain") == 0) ) {
+         NameState state = names[i];
+         resolveNameWithSystem(names[i].Name, state);
+         if(state.Status[0] == QS_NoError) {
+            names[i] = state;
+         }
+      }
+   }
+   for(NameState& state : names) {
+      std::sort(state.Addresses.begin(), state.Addresses.end());
+      state.Addresses.erase(std::unique(state.Addresses.begin(), state.Addresses.end()),
+                            state.Addresses.end());
+   }
+
+   // ====== Print results in input order ===================================
+   RecordWriter writer(os, outputFormat, { { "name",    false },
+                                           { "status",  false },
+                                           { "address", false },
+                                           { "network", false } });
+   for(size_t i = 0; i < inputs.size(); i++) {
+      const NameState& state = names[inputNames[i]];
+      if(state.Addresses.empty()) {
+         writer.write({ inputs[i], nameStatus(state), "", "" });
+      }
+      for(const Prefix& address : state.Addresses) {
+         Prefix network = address;
+         network.length = (address.family == AF_INET) ? ipv4PrefixLength : ipv6PrefixLength;
+         network.network = address.network & netMask(address.family, network.length);
+         writer.write({ inputs[i], nameStatus(state),
+                        addressValueToString(address.family, address.network),
+                        prefixToString(network) });
+      }
+   }
+   writer.finish();
+   return true;
+}
@@ -0,0 +1,246 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "reversezone.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+
+// ###### Label tables ######################################################
+// Pre-formatted labels "0." ... "255." (IPv4 octets) and "0." ... "f."
+// (IPv6 nibbles), so that names are built by copying table entries.
+// The octet table is computed at compile time, not at program start.
+struct LabelTable {
+   char         Label[256][5] { };
+   unsigned int Length[256]   { };
+
+   constexpr LabelTable() {
+      for(unsigned int i = 0; i < 256; i++) {
+         unsigned int n = 0;
+         if(i >= 100) {
+            Label[i][n++] = (char)('0' + (i / 100));
+         }
+         if(i >= 10) {
+            Label[i][n++] = (char)('0' + ((i / 10) % 10));
+         }
+         Label[i][n++] = (char)('0' + (i % 10));
+         Label[i][n++] = '.';
+         Length[i]     = n;
+      }
+   }
+};
+
+static const char NibbleLabel[16][2] = {
+   { '0', '.' }, { '1', '.' }, { '2', '.' }, { '3', '.' },
+   { '4', '.' }, { '5', '.' }, { '6', '.' }, { '7', '.' },
+   { '8', '.' }, { '9', '.' }, { 'a', '.' }, { 'b', '.' },
+   { 'c', '.' }, { 'd', '.' }, { 'e', '.' }, { 'f', '.' }
+};
+
+
+// ###### Reverse name builder ##############################################
+// A reverse name consists of the labels of the varying host part, followed
+// by the fixed suffix of the zone. The suffix is formatted once.
+class ReverseNameBuilder
+{
+   public:
+   ReverseNameBuilder(const unsigned int family,
+                      const AddressValue& zone,
+                      const unsigned int  zoneLabels,
+                      const char*         classlessLabel = nullptr);
+
+   const char* build(const AddressValue& address, const unsigned int labels);
+   inline const std::string& suffix() const { return Suffix; }
+
+   private:
+   inline unsigned int label(const AddressValue& address, const unsigned int i) const {
+      if(Family == AF_INET) {
+         return (unsigned int)(address.low >> (8 * i)) & 0xff;
+      }
+      return (unsigned int)(((i < 16) ? (address.low  >> (4 * i)) :
+                                        (address.high >> (4 * (i - 16)))) & 0x0f);
+   }
+
+   static constexpr LabelTable OctetTable { };
+   const unsigned int          Family;
+   const unsigned int          TotalLabels;
+   std::string                 Suffix;
+   char                        Buffer[160];
+};
+
+
+// ###### Constructor #######################################################
+ReverseNameBuilder::ReverseNameBuilder(const unsigned int  family,
+                                       const AddressValue& zone,
+                                       const unsigned int  zoneLabels,
+                                       const char*         classlessLabel)
+   : Family(family),
+     TotalLabels((family == AF_INET) ? 4 : 32)
+{
+   if(classlessLabel != nullptr) {
+      Suffix += classlessLabel;
+      Suffix += ".";
+   }
+   for(unsigned int i = TotalLabels - zoneLabels; i < TotalLabels; i++) {
+      const unsigned int l = label(zone, i);
+      if(Family == AF_INET) {
+         Suffix.append(OctetTable.Label[l], OctetTable.Length[l]);
+      }
+      else {
+         Suffix.append(NibbleLabel[l], 2);
+      }
+   }
+   Suffix += (Family == AF_INET) ? "in-addr.arpa." : "ip6.arpa.";
+}
+
+
+// ###### Build name for address ############################################
+// Only the lowest "labels" labels of the address are formatted.
+const char* ReverseNameBuilder::build(const AddressValue& address,
+                                      const unsigned int  labels)
+{
+   char* p = Buffer;
+   for(unsigned int i = 0; i < labels; i++) {
+      const unsigned int l = label(address, i);
+      if(Family == AF_INET) {
+         memcpy(p, OctetTable.Label[l], 4);
+         p += OctetTable.Length[l];
+      }
+      else {
+         memcpy(p, NibbleLabel[l], 2);
+         p += 2;
+      }
+   }
+   memcpy(p, Suffix.c_str(), Suffix.size() + 1);
+   return Buffer;
+}
+
+
+// ###### Parse reverse mode ################################################
+bool parseReverseMode(const char* string, ReverseMode& reverseMode)
+{
+   if(strcmp(string, "zone") == 0) {
+      reverseMode = RM_Zone;
+   }
+   else if(strcmp(string, "ptr") == 0) {
+      reverseMode = RM_PTR;
+   }
+   else if(strcmp(string, "cname") == 0) {
+      reverseMode = RM_CNAME;
+   }
+   else {
+      return false;
+   }
+   return true;
+}
+
+
+// ###### Print reverse zone names or records ###############################
+// Zones are delegated on octet (IPv4) or nibble (IPv6) boundaries. A prefix
+// between these boundaries is covered by several zones. IPv4 prefixes of
+// length /25 to /31 use RFC 2317 classless delegation, i.e. a zone named
+// "<first>/<length>.c.b.a.in-addr.arpa." and CNAME records for its hosts
+// in the parent zone.
+bool printReverseZone(std::ostream&      os,
+                      const OutputFormat outputFormat,
+                      const ReverseMode  reverseMode,
+                      const Prefix&      parent)
+{
+   const unsigned int bitsPerLabel = (parent.family == AF_INET) ? 8 : 4;
+   const unsigned int totalLabels  = familyBits(parent.family) / bitsPerLabel;
+   const bool         classless    = (parent.family == AF_INET) &&
+                                     (parent.length > 24) && (parent.length < 32);
+   const unsigned int zoneLabels   = classless ? 3 :
+      (parent.length + bitsPerLabel - 1) / bitsPerLabel;
+   const std::string  classlessLabel =
+      std::to_string((unsigned int)(parent.network.low & 0xff)) + "/" +
+      std::to_string((unsigned int)parent.length);
+
+   // ====== Zone names =====================================================
+   if(reverseMode == RM_Zone) {
+      RecordWriter       writer(os, outputFormat, { { "zone", false } });
+      const unsigned int spareBits = classless ? 0 :
+                                        zoneLabels * bitsPerLabel - parent.length;
+      const AddressValue step = hostMask(parent.family, zoneLabels * bitsPerLabel);
+      AddressValue       zone = parent.network;
+      for(unsigned int i = 0; i < (1U << spareBits); i++) {
+         ReverseNameBuilder builder(parent.family, zone, zoneLabels,
+                                    classless ? classlessLabel.c_str() : nullptr);
+         writer.write({ builder.suffix() });
+         zone = increment(zone | step);
+      }
+      writer.finish();
+      return true;
+   }
+
+   // ====== Records for all hosts ==========================================
+   if( (reverseMode == RM_CNAME) && (!classless) ) {
+      std::cerr << gettext("ERROR: Classless delegation (RFC 2317) is only applicable for IPv4 prefixes of length /25 to /31!") << "\n";
+      return false;
+   }
+   const unsigned int  fixedLabels = (reverseMode == RM_CNAME) ?
+                                        3 : parent.length / bitsPerLabel;
+   const unsigned int  hostLabels  = totalLabels - fixedLabels;
+   ReverseNameBuilder  ownerBuilder(parent.family, parent.network, fixedLabels,
+                                    ((reverseMode == RM_PTR) && (classless)) ?
+                                       classlessLabel.c_str() : nullptr);
+   ReverseNameBuilder  targetBuilder(parent.family, parent.network, fixedLabels,
+                                     classlessLabel.c_str());
+   RecordWriter writer(os, outputFormat,
+                       (reverseMode == RM_PTR) ?
+                          std::vector<RecordField> { { "name",    false },
+                                                     { "address", false } } :
+                          std::vector<RecordField> { { "name",    false },
+                                                     { "type",    false },
+                                                     { "target",  false } });
+   const AddressValue last    = lastAddress(parent);
+   AddressValue       address = parent.network;
+   while(true) {
+      if(!isReservedHost(parent, address)) {
+         if(reverseMode == RM_PTR) {
+            writer.write({ ownerBuilder.build(address, hostLabels),
+                           addressValueToString(parent.family, address) });
+         }
+         else {
+            writer.write({ ownerBuilder.build(address, hostLabels),
+                           "CNAME",
+                           targetBuilder.build(address, hostLabels) });
+         }
+      }
+      if(address == last) {
+         break;
+      }
+      address = increment(address);
+   }
+   writer.finish();
+   return true;
+}
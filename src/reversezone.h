@@ -0,0 +1,51 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef REVERSEZONE_H
+#define REVERSEZONE_H
+
+#include "output.h"
+#include "prefixlist.h"
+
+
+enum ReverseMode {
+   RM_Zone  = 0,   // Names of the reverse zones covering the prefix
+   RM_PTR   = 1,   // PTR owner names of all hosts
+   RM_CNAME = 2    // RFC 2317 CNAME records for the parent zone
+};
+
+bool parseReverseMode(const char* string, ReverseMode& reverseMode);
+
+bool printReverseZone(std::ostream&      os,
+                      const OutputFormat outputFormat,
+                      const ReverseMode  reverseMode,
+                      const Prefix&      parent);
+
+#endif
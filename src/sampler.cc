@@ -0,0 +1,164 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "sampler.h"
+
+#include <iostream>
+
+
+// ###### Keyed pseudo-random permutation of [0, 2^bits) ####################
+// A balanced Feistel network over 2*ceil(bits/2) bits. For an odd number of
+// bits, results outside of the domain are encrypted again (cycle-walking),
+// so that the permutation stays within [0, 2^bits). Only the round keys
+// are stored, i.e. the memory usage is independent of the domain size.
+class FeistelPermutation
+{
+   public:
+   FeistelPermutation(const unsigned int bits, uint64_t seed);
+   AddressValue permute(const AddressValue& value) const;
+
+   private:
+   static const unsigned int Rounds = 8;
+
+   static uint64_t mix(uint64_t z);
+   AddressValue encrypt(const AddressValue& value) const;
+
+   const unsigned int Bits;
+   const unsigned int HalfBits;
+   const uint64_t     HalfMask;
+   uint64_t           Key[Rounds];
+};
+
+
+// ###### Constructor #######################################################
+FeistelPermutation::FeistelPermutation(const unsigned int bits, uint64_t seed)
+   : Bits(bits),
+     HalfBits((bits + 1) / 2),
+     HalfMask((HalfBits >= 64) ? ~0ULL : ((1ULL << HalfBits) - 1))
+{
+   for(unsigned int i = 0; i < Rounds; i++) {
+      seed  += 0x9e3779b97f4a7c15ULL;   // SplitMix64 sequence
+      Key[i] = mix(seed);
+   }
+}
+
+
+// ###### SplitMix64 finaliser ##############################################
+uint64_t FeistelPermutation::mix(uint64_t z)
+{
+   z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+   return z ^ (z >> 31);
+}
+
+
+// ###### One pass of the Feistel network ###################################
+AddressValue FeistelPermutation::encrypt(const AddressValue& value) const
+{
+   // ====== Split value into halves ========================================
+   uint64_t left;
+   uint64_t right;
+   if(HalfBits == 64) {
+      left  = value.high;
+      right = value.low;
+   }
+   else {
+      left  = ((value.low >> HalfBits) | (value.high << (64 - HalfBits))) & HalfMask;
+      right = value.low & HalfMask;
+   }
+
+   // ====== Apply rounds ===================================================
+   for(unsigned int i = 0; i < Rounds; i++) {
+      const uint64_t f = mix(right ^ Key[i]) & HalfMask;
+      const uint64_t l = left;
+      left  = right;
+      right = l ^ f;
+   }
+
+   // ====== Combine halves =================================================
+   if(HalfBits == 64) {
+      return AddressValue { left, right };
+   }
+   return AddressValue { left >> (64 - HalfBits), (left << HalfBits) | right };
+}
+
+
+// ###### Map value to its permuted value ###################################
+AddressValue FeistelPermutation::permute(const AddressValue& value) const
+{
+   if(Bits == 0) {
+      return value;
+   }
+   AddressValue result = encrypt(value);
+   if(2 * HalfBits != Bits) {
+      // ------ Cycle-walking: the domain has one bit less ------------------
+      const unsigned int topBit = Bits;
+      while( (topBit < 64) ? ((result.low  >> topBit) & 1) :
+                             ((result.high >> (topBit - 64)) & 1) ) {
+         result = encrypt(result);
+      }
+   }
+   return result;
+}
+
+
+// ###### Print distinct pseudo-random hosts of a prefix ####################
+// The counter 0, 1, 2, ... is mapped through a permutation of the host
+// part, which is keyed by the seed. This results in distinct hosts in a
+// reproducible order, without keeping track of the hosts already printed.
+bool sampleHosts(std::ostream&            os,
+                 const OutputFormat       outputFormat,
+                 const Prefix&            parent,
+                 const unsigned long long count,
+                 const uint64_t           seed)
+{
+   const unsigned int hostBits = familyBits(parent.family) - parent.length;
+   if( (hostBits < 64) &&
+       (count > (1ULL << hostBits) - reservedHosts(parent)) ) {
+      std::cerr << format(gettext("ERROR: Only %llu unique values are available!"),
+                          (1ULL << hostBits) - reservedHosts(parent)) << "\n";
+      return false;
+   }
+
+   const FeistelPermutation permutation(hostBits, seed);
+   RecordWriter             writer(os, outputFormat, { { "address", false } });
+   unsigned long long       printed = 0;
+   for(uint64_t counter = 0; printed < count; counter++) {
+      const AddressValue host =
+         parent.network | permutation.permute(AddressValue { 0, counter });
+      if(isReservedHost(parent, host)) {
+         continue;
+      }
+      writer.write({ addressValueToString(parent.family, host) });
+      printed++;
+   }
+   writer.finish();
+   return true;
+}
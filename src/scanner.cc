@@ -0,0 +1,299 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "scanner.h"
+#include "prefixlist.h"
+#include "properties.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+// ###### Is character part of an address? #################################
+static inline bool isAddressCharacter(const unsigned char c)
+{
+   return ((unsigned int)(c - '0') <= 9) ||
+          ((unsigned int)((c | 0x20) - 'a') <= 5) ||
+          (c == ':') || (c == '.');
+}
+
+
+// ###### Is character part of a word? #####################################
+static inline bool isWordCharacter(const unsigned char c)
+{
+   return ((unsigned int)(c - '0') <= 9) ||
+          ((unsigned int)((c | 0x20) - 'a') <= 25) ||
+          (c == '_');
+}
+
+
+// ###### Find next digit or colon ##########################################
+// Every IPv4 address contains a digit, and every IPv6 address contains a
+// colon. Runs of other characters are skipped 16 bytes at a time.
+static inline const char* findAnchor(const char* p, const char* end)
+{
+#if defined(__SSE2__)
+   const __m128i zero  = _mm_set1_epi8('0');
+   const __m128i nine  = _mm_set1_epi8(9);
+   const __m128i colon = _mm_set1_epi8(':');
+   while(end - p >= 16) {
+      const __m128i v       = _mm_loadu_si128((const __m128i*)p);
+      const __m128i d       = _mm_sub_epi8(v, zero);
+      const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+      const __m128i isColon = _mm_cmpeq_epi8(v, colon);
+      const int     mask    = _mm_movemask_epi8(_mm_or_si128(isDigit, isColon));
+      if(mask != 0) {
+         return p + __builtin_ctz(mask);
+      }
+      p += 16;
+   }
+#endif
+   while(p < end) {
+      if( ((unsigned int)(*p - '0') <= 9) || (*p == ':') ) {
+         return p;
+      }
+      p++;
+   }
+   return end;
+}
+
+
+// ###### Parse IPv4 address not glued to a preceding word ##################
+static inline bool parseUngluedIPv4Address(const char*   line,
+                                           const char*   begin,
+                                           const char*   end,
+                                           AddressValue& value)
+{
+   // Skip leading hex letters, which are part of the token
+   while( (begin < end) && ((unsigned int)(*begin - '0') > 9) ) {
+      begin++;
+   }
+   if( (begin > line) && (isWordCharacter(begin[-1])) ) {
+      return false;
+   }
+   return parseIPv4Address(begin, (size_t)(end - begin), value);
+}
+
+
+// ###### Try to parse candidate token as address ###########################
+// Candidates glued to a preceding word (e.g. "host10.0.0.1" or "std::map")
+// are rejected. An IPv6 candidate needs at least two groups, or a "::"
+// not glued to a following word (e.g. "fe80::", but not "d::vector").
+// Otherwise, an IPv4 address may be preceded by "name:" and followed by
+// ":port", e.g. "host:192.0.2.1:80".
+static bool parseCandidate(const char*   line,
+                           const char*   lineEnd,
+                           const char*   begin,
+                           const char*   end,
+                           unsigned int& family,
+                           AddressValue& value)
+{
+   // ====== Strip trailing separators, e.g. end of sentence ================
+   while( (end > begin) && (end[-1] == '.') ) {
+      end--;
+   }
+   if(end == begin) {
+      return false;
+   }
+   const size_t length = (size_t)(end - begin);
+
+   const char* colon = (const char*)memchr(begin, ':', length);
+   if(colon == nullptr) {
+      family = AF_INET;
+      return parseUngluedIPv4Address(line, begin, end, value);
+   }
+
+   // ====== IPv6 candidate =================================================
+   family = AF_INET6;
+   const char* addressEnd = nullptr;
+   if( (begin > line) && (isWordCharacter(begin[-1])) ) {
+      // Glued to a preceding word, but may be "name:" of an IPv4 address
+   }
+   else if(parseIPv6Address(begin, length, value)) {
+      addressEnd = end;
+   }
+   else if( (length > 2) && (end[-1] == ':') && (end[-2] != ':') &&
+            parseIPv6Address(begin, length - 1, value) ) {
+      addressEnd = end - 1;   // E.g. "2001:db8::1: message"
+   }
+   if(addressEnd != nullptr) {
+      unsigned int groups = 0;
+      for(const char* c = begin; c < addressEnd; c++) {
+         if( (*c != ':') && ((c == begin) || (c[-1] == ':')) ) {
+            groups++;
+         }
+      }
+      if( (groups >= 2) ||
+          (addressEnd == lineEnd) || (!isWordCharacter(*addressEnd)) ) {
+         return true;
+      }
+      return false;
+   }
+
+   // ====== IPv4 address with name and/or port, e.g. "192.0.2.1:80" ========
+   // The address is in front of the last colon if only port digits follow
+   // it (e.g. "192.0.2.1:80" or "192.0.2.1:"), otherwise behind it.
+   family = AF_INET;
+   const char* lastColon = end - 1;
+   while(*lastColon != ':') {
+      lastColon--;
+   }
+   const char* p = lastColon + 1;
+   while( (p < end) && ((unsigned int)(*p - '0') <= 9) ) {
+      p++;
+   }
+   if(p < end) {
+      return parseUngluedIPv4Address(line, lastColon + 1, end, value);
+   }
+   const char* addressBegin = lastColon;
+   while( (addressBegin > begin) && (addressBegin[-1] != ':') ) {
+      addressBegin--;
+   }
+   return parseUngluedIPv4Address(line, addressBegin, lastColon, value);
+}
+
+
+// ###### Scan one line for addresses #######################################
+static void scanLine(RecordWriter&       writer,
+                     const char*         line,
+                     const char*         end,
+                     unsigned long long  lineNumber,
+                     const unsigned int  ipv4PrefixLength,
+                     const unsigned int  ipv6PrefixLength)
+{
+   const char* p = line;
+   while(p < end) {
+      const char* anchor = findAnchor(p, end);
+      if(anchor == end) {
+         break;
+      }
+
+      // ====== Expand anchor to token of address characters ================
+      const char* begin = anchor;
+      while( (begin > p) && isAddressCharacter(begin[-1]) ) {
+         begin--;
+      }
+      const char* tokenEnd = anchor + 1;
+      while( (tokenEnd < end) && isAddressCharacter(*tokenEnd) ) {
+         tokenEnd++;
+      }
+      p = tokenEnd;
+
+      // ====== Validate and annotate =======================================
+      unsigned int family;
+      AddressValue value;
+      if( (tokenEnd - begin >= 2) &&
+          (parseCandidate(line, end, begin, tokenEnd, family, value)) ) {
+         sockaddr_union address;
+         Prefix         network;
+         valueToAddress(family, value, address);
+         makePrefix(address,
+                    (family == AF_INET) ? ipv4PrefixLength : ipv6PrefixLength,
+                    network);
+         writer.write({ std::to_string(lineNumber),
+                        addressValueToString(family, value),
+                        prefixToString(network),
+                        propertiesToString(getAddressProperties(address)) });
+      }
+   }
+}
+
+
+// ###### Scan text for IPv4/IPv6 addresses #################################
+bool scanAddresses(std::ostream&      os,
+                   const OutputFormat outputFormat,
+                   const char*        fileName,
+                   const unsigned int ipv4PrefixLength,
+                   const unsigned int ipv6PrefixLength)
+{
+   int fd = STDIN_FILENO;
+   if(strcmp(fileName, "-") != 0) {
+      fd = open(fileName, O_RDONLY);
+      if(fd < 0) {
+         std::cerr << format(gettext("ERROR: Unable to open %s!"), fileName) << "\n";
+         return false;
+      }
+   }
+
+   RecordWriter writer(os, outputFormat, { { "line",       true  },
+                                           { "address",    false },
+                                           { "network",    false },
+                                           { "properties", false } });
+   std::vector<char>  buffer(1 << 20);
+   size_t             used       = 0;
+   unsigned long long lineNumber = 0;
+   bool               success    = true;
+   for(;;) {
+      if(used == buffer.size()) {
+         buffer.resize(2 * buffer.size());   // Very long line
+      }
+      const ssize_t r = read(fd, buffer.data() + used, buffer.size() - used);
+      if(r < 0) {
+         std::cerr << format(gettext("ERROR: Unable to read from %s!"), fileName) << "\n";
+         success = false;
+         break;
+      }
+      const bool  eof   = (r == 0);
+      used += (size_t)r;
+
+      // ====== Process complete lines ======================================
+      const char* p   = buffer.data();
+      const char* end = buffer.data() + used;
+      for(;;) {
+         const char* newline = (const char*)memchr(p, '\n', end - p);
+         if(newline == nullptr) {
+            if( (eof) && (p < end) ) {
+               scanLine(writer, p, end, ++lineNumber, ipv4PrefixLength, ipv6PrefixLength);
+               p = end;
+            }
+            break;
+         }
+         scanLine(writer, p, newline, ++lineNumber, ipv4PrefixLength, ipv6PrefixLength);
+         p = newline + 1;
+      }
+      used = end - p;
+      memmove(buffer.data(), p, used);
+      if(eof) {
+         break;
+      }
+   }
+
+   if(fd != STDIN_FILENO) {
+      close(fd);
+   }
+   return success;
+}
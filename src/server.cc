@@ -0,0 +1,407 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#include "server.h"
+#include "tools.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__linux__)
+#define HAVE_EPOLL
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+
+static const size_t MaxQueryLength = 65536;
+
+static volatile sig_atomic_t StopServer = 0;
+
+
+// ====== Client connection =================================================
+struct Connection {
+   std::string Input;
+   std::string Output;
+   bool        Closing;
+};
+
+
+// ###### Signal handler ####################################################
+static void stopServer(int)
+{
+   StopServer = 1;
+}
+
+
+// ###### Make socket non-blocking ##########################################
+static bool setNonBlocking(const int sd)
+{
+   const int flags = fcntl(sd, F_GETFL, 0);
+   return (flags >= 0) && (fcntl(sd, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+
+// ###### Fill UNIX socket address ##########################################
+static bool makeSocketAddress(const char* socketPath, sockaddr_un& address)
+{
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   if(strlen(socketPath) >= sizeof(address.sun_path)) {
+      std::cerr << format(gettext("ERROR: Socket path %s is too long!"), socketPath) << "\n";
+      return false;
+   }
+   strcpy(address.sun_path, socketPath);
+   return true;
+}
+
+
+// ###### Answer complete queries ##########################################
+// Returns false, if the unterminated remainder of the input is too long.
+static bool answerQueries(Connection& connection, const QueryHandler& queryHandler)
+{
+   size_t begin = 0;
+   size_t end;
+   while( (end = connection.Input.find('\n', begin)) != std::string::npos ) {
+      const std::string  query = connection.Input.substr(begin, end - begin);
+      std::ostringstream response;
+      const bool         success = queryHandler(query, response);
+      const std::string  result  = response.str();
+      connection.Output += format("%s %zu\n", (success ? "OK" : "ERROR"), result.size());
+      connection.Output += result;
+      begin = end + 1;
+   }
+   connection.Input.erase(0, begin);
+   return (connection.Input.size() <= MaxQueryLength);
+}
+
+
+// ###### Handle incoming data ##############################################
+// Returns false, if the connection has to be closed.
+static bool handleInput(const int           sd,
+                        Connection&         connection,
+                        const QueryHandler& queryHandler)
+{
+   // ====== Read all available data and answer complete queries ============
+   char buffer[16384];
+   while(true) {
+      const ssize_t received = read(sd, buffer, sizeof(buffer));
+      if(received > 0) {
+         connection.Input.append(buffer, received);
+         if(!answerQueries(connection, queryHandler)) {
+            return false;
+         }
+      }
+      else if(received == 0) {
+         connection.Closing = true;
+         break;
+      }
+      else if( (errno == EAGAIN) || (errno == EWOULDBLOCK) ) {
+         break;
+      }
+      else if(errno != EINTR) {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+// ###### Send pending output ###############################################
+// Returns false, if the connection has to be closed: on error, or when all
+// output has been sent after the client closed its side.
+static bool handleOutput(const int sd, Connection& connection)
+{
+   while(!connection.Output.empty()) {
+      const ssize_t sent = write(sd, connection.Output.data(), connection.Output.size());
+      if(sent > 0) {
+         connection.Output.erase(0, sent);
+      }
+      else if( (sent < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ) {
+         return true;
+      }
+      else if( (sent < 0) && (errno == EINTR) ) {
+         continue;
+      }
+      else {
+         return false;
+      }
+   }
+   return !connection.Closing;
+}
+
+
+// ###### Run query server ##################################################
+// All connections are handled by a single thread, using an epoll() event
+// loop (or poll() on systems without epoll()). Each query is answered as
+// soon as its line is complete.
+bool runServer(const char* socketPath, const QueryHandler& queryHandler)
+{
+   // ====== Create socket ==================================================
+   sockaddr_un address;
+   if(!makeSocketAddress(socketPath, address)) {
+      return false;
+   }
+   const int probeSD = socket(AF_UNIX, SOCK_STREAM, 0);
+   if(probeSD >= 0) {
+      // The state of a socket after a failed connect() is unspecified, so
+      // a separate socket is used to probe for a running server.
+      const bool isRunning = (connect(probeSD, (const sockaddr*)&address, sizeof(address)) == 0);
+      close(probeSD);
+      if(isRunning) {
+         std::cerr << format(gettext("ERROR: A server is already running on %s!"), socketPath) << "\n";
+         return false;
+      }
+   }
+   const int listenSD = socket(AF_UNIX, SOCK_STREAM, 0);
+   if(listenSD < 0) {
+      std::cerr << format(gettext("ERROR: Unable to create socket: %s!"), strerror(errno)) << "\n";
+      return false;
+   }
+   struct stat status;
+   if( (lstat(socketPath, &status) == 0) && (S_ISSOCK(status.st_mode)) ) {
+      unlink(socketPath);   // Remove stale socket
+   }
+   if( (bind(listenSD, (const sockaddr*)&address, sizeof(address)) != 0) ||
+       (listen(listenSD, 128) != 0) ||
+       (!setNonBlocking(listenSD)) ) {
+      std::cerr << format(gettext("ERROR: Unable to bind socket to %s: %s!"),
+                          socketPath, strerror(errno)) << "\n";
+      close(listenSD);
+      return false;
+   }
+
+   // ====== Install signal handlers ========================================
+   struct sigaction action;
+   memset(&action, 0, sizeof(action));
+   action.sa_handler = stopServer;   // No SA_RESTART: interrupt the waiting
+   sigaction(SIGINT,  &action, nullptr);
+   sigaction(SIGTERM, &action, nullptr);
+   signal(SIGPIPE, SIG_IGN);
+
+#ifdef HAVE_EPOLL
+   const int epollFD = epoll_create1(EPOLL_CLOEXEC);
+   if(epollFD < 0) {
+      std::cerr << format(gettext("ERROR: Unable to create epoll instance: %s!"), strerror(errno)) << "\n";
+      close(listenSD);
+      unlink(socketPath);
+      return false;
+   }
+   epoll_event event;
+   memset(&event, 0, sizeof(event));
+   event.events  = EPOLLIN;
+   event.data.fd = listenSD;
+   epoll_ctl(epollFD, EPOLL_CTL_ADD, listenSD, &event);
+#endif
+
+   // ====== Event loop =====================================================
+   std::map<int, Connection> connections;
+   std::vector<int>          readySDs;
+   std::vector<int>          writableSDs;
+   while(!StopServer) {
+      readySDs.clear();
+      writableSDs.clear();
+
+      // ====== Wait for events =============================================
+#ifdef HAVE_EPOLL
+      epoll_event events[64];
+      const int   n = epoll_wait(epollFD, events, 64, -1);
+      for(int i = 0; i < n; i++) {
+         if(events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            readySDs.push_back(events[i].data.fd);
+         }
+         if(events[i].events & EPOLLOUT) {
+            writableSDs.push_back(events[i].data.fd);
+         }
+      }
+#else
+      std::vector<pollfd> pollFDs;
+      pollFDs.push_back(pollfd { listenSD, POLLIN, 0 });
+      for(const auto& connection : connections) {
+         pollFDs.push_back(pollfd { connection.first,
+                                    (short)(connection.second.Output.empty() ?
+                                               POLLIN : (POLLIN | POLLOUT)), 0 });
+      }
+      const int n = poll(pollFDs.data(), pollFDs.size(), -1);
+      for(const pollfd& p : pollFDs) {
+         if(p.revents & (POLLIN | POLLHUP | POLLERR)) {
+            readySDs.push_back(p.fd);
+         }
+         if(p.revents & POLLOUT) {
+            writableSDs.push_back(p.fd);
+         }
+      }
+#endif
+      if( (n < 0) && (errno != EINTR) ) {
+         std::cerr << format(gettext("ERROR: Waiting for events failed: %s!"), strerror(errno)) << "\n";
+         break;
+      }
+
+      // ====== Handle events ===============================================
+      for(const int sd : readySDs) {
+         if(sd == listenSD) {
+            // ------ Accept new connections --------------------------------
+            int clientSD;
+            while( (clientSD = accept(listenSD, nullptr, nullptr)) >= 0 ) {
+               if(!setNonBlocking(clientSD)) {
+                  close(clientSD);
+                  continue;
+               }
+               connections[clientSD] = Connection { std::string(), std::string(), false };
+#ifdef HAVE_EPOLL
+               event.events  = EPOLLIN;
+               event.data.fd = clientSD;
+               epoll_ctl(epollFD, EPOLL_CTL_ADD, clientSD, &event);
+#endif
+            }
+            continue;
+         }
+         writableSDs.push_back(sd);   // Try to send response immediately
+      }
+      std::sort(writableSDs.begin(), writableSDs.end());
+      writableSDs.erase(std::unique(writableSDs.begin(), writableSDs.end()),
+                        writableSDs.end());
+      for(const int sd : writableSDs) {
+         auto found = connections.find(sd);
+         if(found == connections.end()) {
+            continue;
+         }
+         Connection& connection = found->second;
+         const bool  wasPending = !connection.Output.empty();
+         bool        keep       = true;
+         if(std::find(readySDs.begin(), readySDs.end(), sd) != readySDs.end()) {
+            keep = handleInput(sd, connection, queryHandler);
+         }
+         if(keep) {
+            keep = handleOutput(sd, connection);
+         }
+         if(!keep) {
+#ifdef HAVE_EPOLL
+            epoll_ctl(epollFD, EPOLL_CTL_DEL, sd, nullptr);
+#endif
+            close(sd);
+            connections.erase(found);
+            continue;
+         }
+#ifdef HAVE_EPOLL
+         // ------ Only wait for writability while output is pending -------
+         const bool isPending = !connection.Output.empty();
+         if(isPending != wasPending) {
+            event.events  = EPOLLIN | (isPending ? (uint32_t)EPOLLOUT : 0U);
+            event.data.fd = sd;
+            epoll_ctl(epollFD, EPOLL_CTL_MOD, sd, &event);
+         }
+#endif
+      }
+   }
+
+   // ====== Clean up =======================================================
+   for(const auto& connection : connections) {
+      close(connection.first);
+   }
+#ifdef HAVE_EPOLL
+   close(epollFD);
+#endif
+   close(listenSD);
+   unlink(socketPath);
+   return true;
+}
+
+
+// ###### Send query to server and print response ###########################
+// This function is called before any initialisation (locale, etc.), in
+// order to keep the round trip time as short as possible.
+int runClient(const char* socketPath, const int argc, char** argv)
+{
+   sockaddr_un address;
+   if(!makeSocketAddress(socketPath, address)) {
+      return 1;
+   }
+   const int sd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if( (sd < 0) ||
+       (connect(sd, (const sockaddr*)&address, sizeof(address)) != 0) ) {
+      std::cerr << format(gettext("ERROR: Unable to connect to %s: %s!"),
+                          socketPath, strerror(errno)) << "\n";
+      return 1;
+   }
+
+   // ====== Send query =====================================================
+   std::string query;
+   for(int i = 0; i < argc; i++) {
+      query += ((i > 0) ? " " : "");
+      query += argv[i];
+   }
+   query += "\n";
+   if(write(sd, query.data(), query.size()) != (ssize_t)query.size()) {
+      std::cerr << format(gettext("ERROR: Unable to send query: %s!"), strerror(errno)) << "\n";
+      close(sd);
+      return 1;
+   }
+
+   // ====== Read response ==================================================
+   std::string response;
+   char        buffer[16384];
+   size_t      header = std::string::npos;
+   size_t      length = 0;
+   ssize_t     received;
+   while( (received = read(sd, buffer, sizeof(buffer))) > 0 ) {
+      response.append(buffer, received);
+      if( (header == std::string::npos) &&
+          ((header = response.find('\n')) != std::string::npos) ) {
+         length = strtoul(response.c_str() + response.find(' ') + 1, nullptr, 10);
+      }
+      if( (header != std::string::npos) && (response.size() >= header + 1 + length) ) {
+         break;
+      }
+   }
+   close(sd);
+   if( (header == std::string::npos) || (response.size() < header + 1 + length) ) {
+      std::cerr << gettext("ERROR: Incomplete response from server!") << "\n";
+      return 1;
+   }
+
+   const bool success = (response.compare(0, 3, "OK ") == 0);
+   FILE*      output  = (success ? stdout : stderr);
+   fwrite(response.data() + header + 1, 1, length, output);
+   return (success ? 0 : 1);
+}
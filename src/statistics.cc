@@ -0,0 +1,332 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+
+#include "statistics.h"
+#include "properties.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <sys/stat.h>
+
+
+// ###### Constructor #######################################################
+WideCounter::WideCounter()
+{
+   memset(Limb, 0, sizeof(Limb));
+}
+
+
+// ###### Add 2^exponent ####################################################
+void WideCounter::addPowerOfTwo(const unsigned int exponent)
+{
+   assert(exponent < 32 * Limbs);
+   uint64_t carry = (uint64_t)1 << (exponent % 32);
+   for(unsigned int i = exponent / 32; (carry != 0) && (i < Limbs); i++) {
+      const uint64_t sum = (uint64_t)Limb[i] + carry;
+      Limb[i] = (uint32_t)sum;
+      carry   = sum >> 32;
+   }
+}
+
+
+// ###### Subtract value ####################################################
+void WideCounter::subtract(const uint64_t value)
+{
+   int64_t borrow = 0;
+   for(unsigned int i = 0; i < Limbs; i++) {
+      const int64_t v = (i == 0) ? (int64_t)(value & 0xffffffffULL) :
+                        (i == 1) ? (int64_t)(value >> 32) : 0;
+      int64_t difference = (int64_t)Limb[i] - v - borrow;
+      borrow = 0;
+      if(difference < 0) {
+         difference += (int64_t)1 << 32;
+         borrow = 1;
+      }
+      Limb[i] = (uint32_t)difference;
+   }
+}
+
+
+// ###### Convert to floating-point value ###################################
+double WideCounter::toDouble() const
+{
+   double result = 0.0;
+   for(int i = Limbs - 1; i >= 0; i--) {
+      result = ldexp(result, 32) + (double)Limb[i];
+   }
+   return result;
+}
+
+
+// ###### Convert to decimal string #########################################
+std::string WideCounter::toString() const
+{
+   uint32_t value[Limbs];
+   memcpy(value, Limb, sizeof(value));
+
+   std::string result;
+   for(;;) {
+      // ====== Divide by 10^9, the remainder gives the next 9 digits =======
+      uint64_t remainder = 0;
+      bool     zero      = true;
+      for(int i = Limbs - 1; i >= 0; i--) {
+         const uint64_t current = (remainder << 32) | value[i];
+         value[i]  = (uint32_t)(current / 1000000000ULL);
+         remainder = current % 1000000000ULL;
+         zero      = zero && (value[i] == 0);
+      }
+      char digits[16];
+      snprintf(digits, sizeof(digits), (zero ? "%u" : "%09u"), (unsigned int)remainder);
+      result.insert(0, digits);
+      if(zero) {
+         return result;
+      }
+   }
+}
+
+
+// ###### Counter for prefixes, addresses and hosts #########################
+// The prefixes have to be added in sort order. Then, a prefix either lies
+// within the last counted prefix, or entirely after it. Prefixes within the
+// last counted prefix are not counted again, so that the addresses are the
+// union of all prefixes.
+struct StatisticsCounter {
+   uint64_t     Prefixes = 0;
+   uint64_t     Reserved = 0;        // Addresses not usable for hosts
+   WideCounter  Addresses;
+   bool         Covering = false;    // Is CoveredEnd valid?
+   AddressValue CoveredEnd { 0, 0 }; // Last address of last counted prefix
+
+   inline void add(const Prefix& prefix) {
+      Prefixes++;
+      if( (Covering) && (prefix.network <= CoveredEnd) ) {
+         return;
+      }
+      Covering   = true;
+      CoveredEnd = lastAddress(prefix);
+      Reserved += reservedHosts(prefix);
+      Addresses.addPowerOfTwo(familyBits(prefix.family) - prefix.length);
+   }
+};
+
+
+// ###### Statistics of one address family ##################################
+// All accumulators have fixed size, except for the IPv6 /32 blocks, which
+// only grow with the number of distinct /32 blocks.
+static const unsigned int PropertyCount = __builtin_ctz(AP_6to4) + 1;
+
+struct FamilyStatistics {
+   StatisticsCounter                                 Total;
+   StatisticsCounter                                 Length[129];
+   StatisticsCounter                                 Property[PropertyCount];
+   StatisticsCounter                                 IPv4Block[256];
+   std::unordered_map<uint32_t, StatisticsCounter>   IPv6Block;
+};
+
+
+// ###### Account prefix ####################################################
+// Prefixes are classified by their network address, and accounted to the
+// /8 (IPv4) or /32 (IPv6) block of their network address.
+static void accountPrefix(FamilyStatistics& statistics, const Prefix& prefix)
+{
+   statistics.Total.add(prefix);
+   statistics.Length[prefix.length].add(prefix);
+
+   sockaddr_union network;
+   valueToAddress(prefix.family, prefix.network, network);
+   unsigned int properties = getAddressProperties(network);
+   if(prefix.family == AF_INET) {
+      // IPv4 has no global unicast property: use classes A to C without
+      // special-purpose addresses.
+      if( (properties & (AP_ClassA|AP_ClassB|AP_ClassC)) &&
+          (!(properties & (AP_Loopback|AP_LoopbackNetwork|AP_Private|AP_LinkLocal))) ) {
+         properties |= AP_GlobalUnicast;
+      }
+      statistics.IPv4Block[(prefix.network.low >> 24) & 0xff].add(prefix);
+   }
+   else {
+      statistics.IPv6Block[(uint32_t)(prefix.network.high >> 32)].add(prefix);
+   }
+   for(unsigned int i = 0; i < PropertyCount; i++) {
+      if(properties & (1U << i)) {
+         statistics.Property[i].add(prefix);
+      }
+   }
+}
+
+
+// ###### Write statistics record ###########################################
+static void writeCounter(RecordWriter&            writer,
+                         const std::string&       label,
+                         const unsigned int       family,
+                         const char*              category,
+                         const std::string&       key,
+                         const StatisticsCounter& counter)
+{
+   WideCounter hosts = counter.Addresses;
+   hosts.subtract(counter.Reserved);
+   writer.write({ label, (family == AF_INET) ? "ipv4" : "ipv6", category, key,
+                  std::to_string(counter.Prefixes),
+                  counter.Addresses.toString(), hosts.toString() });
+}
+
+
+// ###### Print statistics of one address family ############################
+static void printFamilyStatistics(RecordWriter&           writer,
+                                  const std::string&      label,
+                                  const unsigned int      family,
+                                  const FamilyStatistics& statistics)
+{
+   if(statistics.Total.Prefixes == 0) {
+      return;
+   }
+   writeCounter(writer, label, family, "total", "", statistics.Total);
+
+   // ====== Prefix length histogram ========================================
+   for(unsigned int length = 0; length <= familyBits(family); length++) {
+      if(statistics.Length[length].Prefixes > 0) {
+         writeCounter(writer, label, family, "length", "/" + std::to_string(length),
+                      statistics.Length[length]);
+      }
+   }
+
+   // ====== Special-purpose classes ========================================
+   for(unsigned int i = 0; i < PropertyCount; i++) {
+      if(statistics.Property[i].Prefixes > 0) {
+         writeCounter(writer, label, family, "class", propertiesToString(1U << i),
+                      statistics.Property[i]);
+      }
+   }
+
+   // ====== Top-level blocks ===============================================
+   Prefix block;
+   block.family = family;
+   block.source = 0;
+   if(family == AF_INET) {
+      block.length = 8;
+      for(unsigned int i = 0; i < 256; i++) {
+         if(statistics.IPv4Block[i].Prefixes > 0) {
+            block.network = AddressValue { 0, (uint64_t)i << 24 };
+            writeCounter(writer, label, family, "block", prefixToString(block),
+                         statistics.IPv4Block[i]);
+         }
+      }
+   }
+   else {
+      block.length = 32;
+      std::vector<uint32_t> blocks;
+      blocks.reserve(statistics.IPv6Block.size());
+      for(const auto& entry : statistics.IPv6Block) {
+         blocks.push_back(entry.first);
+      }
+      std::sort(blocks.begin(), blocks.end());
+      for(const uint32_t b : blocks) {
+         block.network = AddressValue { (uint64_t)b << 32, 0 };
+         writeCounter(writer, label, family, "block", prefixToString(block),
+                      statistics.IPv6Block.find(b)->second);
+      }
+   }
+}
+
+
+// ###### Print statistics of one or more prefix lists ######################
+// Address and host counts are exact unions, i.e. addresses covered by
+// overlapping prefixes are counted once. This needs the prefixes in sort
+// order: a regular file already given in sort order is processed in a single
+// streaming pass, without storing the prefixes. Otherwise (e.g. for standard
+// input), the list is read and sorted in memory.
+bool printStatistics(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const int          listFiles,
+                     char**             listFileNames)
+{
+   RecordWriter writer(os, outputFormat, { { "list",      false },
+                                           { "family",    false },
+                                           { "category",  false },
+                                           { "key",       false },
+                                           { "prefixes",  true  },
+                                           { "addresses", true  },
+                                           { "hosts",     true  } });
+   for(int i = 0; i < listFiles; i++) {
+      std::string                       label;
+      const char*                       fileName = parseListArgument(listFileNames[i], label);
+      std::unique_ptr<FamilyStatistics> ipv4(new FamilyStatistics);
+      std::unique_ptr<FamilyStatistics> ipv6(new FamilyStatistics);
+
+      // ====== Stream the file, as long as it is sorted ====================
+      // Only regular files can be read more than once.
+      bool        sorted = false;
+      struct stat status;
+      if( (strcmp(fileName, "-") != 0) &&
+          (stat(fileName, &status) == 0) && (S_ISREG(status.st_mode)) ) {
+         PrefixListReader reader(fileName);
+         Prefix           previous;
+         Prefix           prefix;
+         bool             first = true;
+         sorted = true;
+         while(reader.next(prefix)) {
+            if( (!first) && (prefix < previous) ) {
+               sorted = false;
+               break;
+            }
+            accountPrefix((prefix.family == AF_INET) ? *ipv4 : *ipv6, prefix);
+            previous = prefix;
+            first    = false;
+         }
+         if(reader.failed()) {
+            return false;
+         }
+      }
+
+      // ====== Otherwise, sort the list in memory ==========================
+      if(!sorted) {
+         std::vector<Prefix> prefixList;
+         if(!readPrefixList(fileName, prefixList)) {
+            return false;
+         }
+         sortPrefixList(prefixList);
+         ipv4.reset(new FamilyStatistics);
+         ipv6.reset(new FamilyStatistics);
+         for(const Prefix& prefix : prefixList) {
+            accountPrefix((prefix.family == AF_INET) ? *ipv4 : *ipv6, prefix);
+         }
+      }
+
+      printFamilyStatistics(writer, label, AF_INET,  *ipv4);
+      printFamilyStatistics(writer, label, AF_INET6, *ipv6);
+   }
+   return true;
+}
@@ -0,0 +1,70 @@
+// ==========================================================================
+//             ____        _     _   _      _    ____      _
+//            / ___| _   _| |__ | \ | | ___| |_ / ___|__ _| | ___
+//            \___ \| | | | '_ \|  \| |/ _ \ __| |   / _` | |/ __|
+//             ___) | |_| | |_) | |\  |  __/ |_| |__| (_| | | (__
+//            |____/ \__,_|_.__/|_| \_|\___|\__|\____\__,_|_|\___|
+//
+//                    ---  IPv4/IPv6 Subnet Calculator  ---
+//                   https://www.nntb.no/~dreibh/subnetcalc/
+// ==========================================================================
+//
+// SubNetCalc - IPv4/IPv6 Subnet Calculator
+// Copyright (C) 2024-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: thomas.dreibholz@gmail.com
+
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include "output.h"
+#include "prefixlist.h"
+
+
+// ###### Exact counter for sums of address block sizes #####################
+// 192 bits are sufficient for up to 2^64 blocks of up to 2^128 addresses.
+class WideCounter
+{
+   public:
+   WideCounter();
+
+   void addPowerOfTwo(const unsigned int exponent);
+   void subtract(const uint64_t value);
+   double toDouble() const;
+   std::string toString() const;
+
+   inline bool isZero() const {
+      for(unsigned int i = 0; i < Limbs; i++) {
+         if(Limb[i] != 0) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   private:
+   static const unsigned int Limbs = 6;
+   uint32_t                  Limb[Limbs];   // Least significant limb first
+};
+
+
+bool printStatistics(std::ostream&      os,
+                     const OutputFormat outputFormat,
+                     const int          listFiles,
+                     char**             listFileNames);
+
+#endif
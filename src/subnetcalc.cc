@@ -29,15 +29,17 @@
 
 #include <cassert>
 #include <cctype>
+#include <cerrno>
 #include <clocale>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
-#include <filesystem>
 #include <fstream>
 #include <getopt.h>
 #include <iostream>
+#include <map>
 #include <netdb.h>
+#include <sstream>
 #include <unistd.h>
 #include <vector>
 
@@ -57,16 +59,27 @@ int getopt_long_only(int argc, char* const* argv, const char* optstring,
 #include <idn2.h>
 #endif
 
-#ifdef ENABLE_NLS
-#include <libintl.h>
-#else
-#define bindtextdomain(domain, dirname) { }
-#define textdomain(domain) { }
-#define gettext(string) string
-#define ngettext(singular, plural, n) ((n) == 1 ? (singular) : (plural))
-#endif
-
 #include "tools.h"
+#include "acl.h"
+#include "addressarray.h"
+#include "addressset.h"
+#include "annotations.h"
+#include "eui64.h"
+#include "generator.h"
+#include "geoip.h"
+#include "hostlist.h"
+#include "inventory.h"
+#include "labels.h"
+#include "multicast.h"
+#include "nat64.h"
+#include "prefixlist.h"
+#include "properties.h"
+#include "resolver.h"
+#include "reversezone.h"
+#include "sampler.h"
+#include "scanner.h"
+#include "server.h"
+#include "statistics.h"
 #include "package-version.h"
 
 
@@ -93,16 +106,30 @@ inline in6_addr getIPv6Address(const sockaddr_union& address)
 }
 
 
-// ###### Is given address a multicast address? #############################
-inline bool isMulticast(const sockaddr_union& address)
+// ###### Replace address, keeping the other fields #########################
+// The other fields (e.g. the port or the scope ID) are taken from "base".
+static sockaddr_union replaceAddress(const sockaddr_union& base,
+                                     const AddressValue&   value)
 {
-   if(isIPv4(address)) {
-      return IN_CLASSD(ntohl(getIPv4Address(address)));
+   sockaddr_union address;
+   sockaddr_union result = base;
+   valueToAddress(base.sa.sa_family, value, address);
+   if(base.sa.sa_family == AF_INET) {
+      result.in.sin_addr = address.in.sin_addr;
    }
    else {
-      const in6_addr ipv6address = getIPv6Address(address);
-      return IN6_IS_ADDR_MULTICAST(&ipv6address);
+      result.in6.sin6_addr = address.in6.sin6_addr;
    }
+   return result;
+}
+
+
+// ###### Is given address a multicast address? #############################
+inline bool isMulticast(const sockaddr_union& address)
+{
+   AddressValue value;
+   addressToValue(address, value);
+   return isMulticastGroup(address.sa.sa_family, value);
 }
 
 
@@ -121,36 +148,10 @@ int readPrefix(const char*           parameter,
    if(prefix < 0) {
       return -1;
    }
-   netmask = forAddress;
-   if(netmask.sa.sa_family == AF_INET) {
-      if(prefix > 32) {
-         return -1;
-      }
-      int p = prefix;
-      netmask.in.sin_addr.s_addr = 0;
-      for(int i = 31; i >= 0; i--) {
-         if(p > 0) {
-            netmask.in.sin_addr.s_addr |= (1U << i);
-         }
-         p--;
-      }
-      netmask.in.sin_addr.s_addr = ntohl(netmask.in.sin_addr.s_addr);
-   }
-   else {
-      if(prefix > 128) {
-         return -1;
-      }
-      int p = prefix;
-      for(int j = 0; j < 16; j++) {
-         netmask.in6.sin6_addr.s6_addr[j] = 0;
-         for(int i = 7; i >= 0; i--) {
-            if(p > 0) {
-               netmask.in6.sin6_addr.s6_addr[j] |= (1U << i);
-            }
-            p--;
-         }
-      }
+   if(prefix > (int)familyBits(forAddress.sa.sa_family)) {
+      return -1;
    }
+   netmask = replaceAddress(forAddress, netMask(forAddress.sa.sa_family, prefix));
    return prefix;
 }
 
@@ -196,74 +197,48 @@ void generateUniqueLocal(sockaddr_union& address,
 }
 
 
-// ###### Print IPv4 address in binary digits ###############################
-void printAddressBinary(std::ostream&         os,
-                        const sockaddr_union& address,
-                        const unsigned int    prefix,
-                        const bool            colourMode = true,
-                        const char*           indent     = "")
+// ###### Print address in binary digits ####################################
+template<unsigned int Family>
+static void printAddressBinary(std::ostream&       os,
+                               const AddressValue& address,
+                               const unsigned int  prefix,
+                               const bool          colourMode,
+                               const char*         indent)
 {
-   if(address.sa.sa_family == AF_INET) {
+   if constexpr(Family == AF_INET) {
       os << indent;
-      uint32_t a = ntohl(getIPv4Address(address));
-      for(int i = 31; i >= 0; i--) {
-         const uint32_t v = (uint32_t)1 << i;
-         if(colourMode) {
-            if(32 - i > (int)prefix) {   // Colourize output
-               os << "\x1b[33m";
-            }
-            else {
-               os << "\x1b[34m";
-            }
-         }
-         if(a >= v) {
-            os << "1";
-            a -= v;
-         }
-         else {
-            os << "0";
+      for(unsigned int i = 0; i < 32; i++) {
+         if(colourMode) {   // Colourize output
+            os << ((i >= prefix) ? "\x1b[33m" : "\x1b[34m");
          }
+         os << (((address.low >> (31 - i)) & 1) ? "1" : "0");
          if(colourMode) {
             os << "\x1b[0m";   // Turn off colour printing
          }
-         if( ((i % 8) == 0) && (i > 0) ) {
+         if( ((i % 8) == 7) && (i < 31) ) {
             os << " . ";
          }
       }
       os << "\n";
    }
    else {
-      int            p           = 0;
-      const in6_addr ipv6Address = getIPv6Address(address);
-      for(int j = 0; j < 8; j++) {
-         uint16_t a = (ipv6Address.s6_addr[j * 2] << 8) | ipv6Address.s6_addr[j * 2 + 1];
-         char     str[16];
+      for(unsigned int j = 0; j < 8; j++) {
+         const uint64_t half = (j < 4) ? address.high : address.low;
+         const uint16_t a    = (uint16_t)(half >> (48 - 16 * (j % 4)));
+         char           str[16];
          snprintf(str, sizeof(str), "%04x", a);
          os << indent << str << " = ";
-         for(int i = 15; i >= 0; i--) {
-            const uint32_t v = (uint32_t)1 << i;
-            if(colourMode) {
-               if(p < (int)prefix) {   // Colourize output
-                  os << "\x1b[33m";
-               }
-               else {
-                  os << "\x1b[34m";
-               }
-            }
-            if(a >= v) {
-               os << "1";
-               a -= v;
-            }
-            else {
-               os << "0";
+         for(unsigned int i = 0; i < 16; i++) {
+            if(colourMode) {   // Colourize output
+               os << ((16 * j + i < prefix) ? "\x1b[33m" : "\x1b[34m");
             }
+            os << (((a >> (15 - i)) & 1) ? "1" : "0");
             if(colourMode) {
                os << "\x1b[0m";   // Turn off colour printing
             }
-            if( ((i % 8) == 0) && (i > 0) ) {
+            if(i == 7) {
                os << " ";
             }
-            p++;
          }
          os << "\n";
       }
@@ -271,100 +246,30 @@ void printAddressBinary(std::ostream&         os,
 }
 
 
-// ###### Is given netmask valid? ###########################################
-int getPrefixLength(const sockaddr_union& netmask)
-{
-   int  prefixLength;
-   bool belongsToNetwork = true;
-
-   if(netmask.sa.sa_family == AF_INET) {
-      prefixLength     = 32;
-      const uint32_t a = ntohl(getIPv4Address(netmask));
-      for(int i = 31; i >= 0; i--) {
-         if(!(a & (1U << (uint32_t)i))) {
-            belongsToNetwork = false;
-            prefixLength--;
-         }
-         else {
-            if(belongsToNetwork == false) {
-               return -1;
-            }
-         }
-      }
-   }
-   else {
-      prefixLength = 128;
-      const in6_addr ip6 = getIPv6Address(netmask);
-      for(int j = 0; j < 4; j++) {
-         const uint32_t a = ((uint32_t)ip6.s6_addr[j * 4]     << 24) |
-                            ((uint32_t)ip6.s6_addr[j * 4 + 1] << 16) |
-                            ((uint32_t)ip6.s6_addr[j * 4 + 2] << 8)  |
-                            ((uint32_t)ip6.s6_addr[j * 4 + 3]);
-         for(int i = 31; i >= 0; i--) {
-            if(!(a & (1U << (uint32_t)i))) {
-               belongsToNetwork = false;
-               prefixLength--;
-            }
-            else {
-               if(belongsToNetwork == false) {
-                  return -1;
-               }
-            }
-         }
-      }
-   }
-   return prefixLength;
-}
-
-
-// ###### "&" operator for addresses ########################################
-sockaddr_union operator&(const sockaddr_union& a1, const sockaddr_union& a2)
-{
-   assert(a1.sa.sa_family == a2.sa.sa_family);
-
-   sockaddr_union a = a1;
-   if(a.sa.sa_family == AF_INET) {
-      a.in.sin_addr.s_addr &= a2.in.sin_addr.s_addr;
-   } else {
-      for(int j = 0; j < 16; j++) {
-         a.in6.sin6_addr.s6_addr[j] &= a2.in6.sin6_addr.s6_addr[j];
-      }
-   }
-   return a;
-}
-
-
-// ###### "|" operator for addresses ########################################
-sockaddr_union operator|(const sockaddr_union& a1, const sockaddr_union& a2)
+// ###### Print address in binary digits ####################################
+void printAddressBinary(std::ostream&         os,
+                        const sockaddr_union& address,
+                        const unsigned int    prefix,
+                        const bool            colourMode = true,
+                        const char*           indent     = "")
 {
-   assert(a1.sa.sa_family == a2.sa.sa_family);
-
-   sockaddr_union a = a1;
-   if(a.sa.sa_family == AF_INET) {
-      a.in.sin_addr.s_addr |= a2.in.sin_addr.s_addr;
+   AddressValue value;
+   addressToValue(address, value);
+   if(address.sa.sa_family == AF_INET) {
+      printAddressBinary<AF_INET>(os, value, prefix, colourMode, indent);
    }
    else {
-      for(int j = 0; j < 16; j++) {
-         a.in6.sin6_addr.s6_addr[j] |= a2.in6.sin6_addr.s6_addr[j];
-      }
+      printAddressBinary<AF_INET6>(os, value, prefix, colourMode, indent);
    }
-   return a;
 }
 
 
-// ###### "~" operator for addresses ########################################
-sockaddr_union operator~(const sockaddr_union& a1)
+// ###### Is given netmask valid? ###########################################
+int getPrefixLength(const sockaddr_union& netmask)
 {
-   sockaddr_union a = a1;
-   if(a.sa.sa_family == AF_INET) {
-      a.in.sin_addr.s_addr = ~a1.in.sin_addr.s_addr;
-   }
-   else {
-      for(int j = 0; j < 16; j++) {
-         a.in6.sin6_addr.s6_addr[j] = ~a1.in6.sin6_addr.s6_addr[j];
-      }
-   }
-   return a;
+   AddressValue value;
+   addressToValue(netmask, value);
+   return maskLength(netmask.sa.sa_family, value);
 }
 
 
@@ -376,70 +281,14 @@ std::ostream& operator<<(std::ostream& os, const sockaddr_union& a)
 }
 
 
-// ###### "+" operator for addresses ########################################
-sockaddr_union operator+(const sockaddr_union& a1, uint32_t n)
-{
-   sockaddr_union a = a1;
-   if(a.sa.sa_family == AF_INET) {
-      a.in.sin_addr.s_addr = htonl(ntohl(a.in.sin_addr.s_addr) + n);
-   }
-   else {
-      union {
-         uint8_t  b[16];
-         uint32_t w[4];
-      } local;
-      std::memcpy(local.b, a.in6.sin6_addr.s6_addr, 16);
-      for(int j = 3; j >= 0; j--) {
-         const uint64_t sum = static_cast<uint64_t>(ntohl(local.w[j])) + static_cast<uint64_t>(n);
-         local.w[j] = htonl(static_cast<uint32_t>(sum & 0xffffffffULL));
-         n = static_cast<uint32_t>(sum >> 32);
-      }
-      std::memcpy(a.in6.sin6_addr.s6_addr, local.b, 16);
-   }
-   return a;
-}
-
-
-// ###### "-" operator for addresses ########################################
-sockaddr_union operator-(const sockaddr_union& a1, uint32_t n)
-{
-   sockaddr_union a = a1;
-   if(a.sa.sa_family == AF_INET) {
-      a.in.sin_addr.s_addr = htonl(ntohl(a.in.sin_addr.s_addr) - n);
-   }
-   else {
-      union {
-         uint8_t  b[16];
-         uint32_t w[4];
-      } local;
-      std::memcpy(local.b, a.in6.sin6_addr.s6_addr, 16);
-      for(int j = 3; j >= 0; j--) {
-         const uint64_t sum = static_cast<uint64_t>(ntohl(local.w[j])) - static_cast<uint64_t>(n);
-         local.w[j] = htonl(static_cast<uint32_t>(sum & 0xffffffffULL));
-         n = static_cast<uint32_t>(sum >> 32);
-      }
-      std::memcpy(a.in6.sin6_addr.s6_addr, local.b, 16);
-   }
-   return a;
-}
-
-
 // ###### "==" operator for addresses #######################################
 bool operator==(const sockaddr_union& a1, const sockaddr_union& a2)
 {
-   assert(a1.sa.sa_family == a2.sa.sa_family);
-
-   if(a1.sa.sa_family == AF_INET) {
-      return (a1.in.sin_addr.s_addr == a2.in.sin_addr.s_addr);
-   }
-   else {
-      for(int j = 0; j < 16; j++) {
-         if(a1.in6.sin6_addr.s6_addr[j] != a2.in6.sin6_addr.s6_addr[j]) {
-            return false;
-         }
-      }
-      return true;
-   }
+   AddressValue v1;
+   AddressValue v2;
+   addressToValue(a1, v1);
+   addressToValue(a2, v2);
+   return (a1.sa.sa_family == a2.sa.sa_family) && (v1 == v2);
 }
 
 
@@ -460,7 +309,7 @@ void printUnicastProperties(std::ostream&   os,
       char globalIDString[16];
       snprintf(globalIDString, sizeof(globalIDString), "%02x%04x%04x",
                word[0] & 0xff, word[1], word[2]);
-      os << "      + " << format(gettext("%-32s"), gettext("Global ID")) << " = " << globalIDString << "\n";
+      os << outputLabel(OL_GlobalID) << globalIDString << "\n";
    }
 
    // ====== Subnet ID ======================================================
@@ -468,7 +317,7 @@ void printUnicastProperties(std::ostream&   os,
       char           subnetIDString[16];
       const uint16_t subnetID = word[3];
       snprintf(subnetIDString, sizeof(subnetIDString), "%04x", subnetID);
-      os << "      + " << format(gettext("%-32s"), gettext("Subnet ID")) << " = " <<  subnetIDString << "\n";
+      os << outputLabel(OL_SubnetID) << subnetIDString << "\n";
    }
 
    // ====== Interface ID ===================================================
@@ -481,7 +330,7 @@ void printUnicastProperties(std::ostream&   os,
             (interfaceID[1] & 0xff00) >> 8, (interfaceID[1] & 0x00ff),
             (interfaceID[2] & 0xff00) >> 8, (interfaceID[2] & 0x00ff),
             interfaceID[3]);
-   os << "      + " << format(gettext("%-32s"), gettext("Interface ID")) << " = " <<  interfaceIDString << "\n";
+   os << outputLabel(OL_InterfaceID) << interfaceIDString << "\n";
 
    if( ((interfaceID[1] & 0x00ff) == 0x00ff) &&
        ((interfaceID[2] & 0xff00) == 0xfe00) ) {
@@ -494,7 +343,7 @@ void printUnicastProperties(std::ostream&   os,
                ipv6address.s6_addr[13],
                ipv6address.s6_addr[14],
                ipv6address.s6_addr[15]);
-      os << "      + " << format(gettext("%-32s"), gettext("MAC Address")) << " = " <<  interfaceIDString << "\n";
+      os << outputLabel(OL_MACAddress) << interfaceIDString << "\n";
    }
 
    // ====== Solicited Node Multicast Address ===============================
@@ -504,7 +353,7 @@ void printUnicastProperties(std::ostream&   os,
                                     "ff02::1:ff%02x:%04x"),
             word[6] & 0xff,
             word[7]);
-   os << "      + " << format(gettext("%-32s"), gettext("Solicited Node Multicast Address")) << " = " <<  snmcAddressString << "\n";
+   os << outputLabel(OL_SolicitedNodeAddress) << snmcAddressString << "\n";
 }
 
 
@@ -521,101 +370,95 @@ void printAddressProperties(std::ostream&         os,
    address2string(&address.sa, addressString, sizeof(addressString), false, false);
 
    // ====== Common properties ==============================================
-   os << format(gettext("%-14s"), gettext("Properties")) << " = \n";
+   os << outputLabel(OL_Properties) << "\n";
    os << "   - ";
    if(isMulticast(address)) {
-      os << format(gettext("%s is a MULTICAST address"), addressString);
+      os << format(outputLabel(OL_IsMulticastFormat).c_str(), addressString);
    }
    else if( (isIPv4(address)) &&
             (prefix < 32) &&
             (address == broadcast) ) {
       char networkString[64];
       address2string(&network.sa, networkString, sizeof(networkString), false, false);
-      os << format(gettext("%s is the BROADCAST address of %s/%u"),
+      os << format(outputLabel(OL_IsBroadcastFormat).c_str(),
                    addressString, networkString, prefix);
    }
    else if( (address == network) &&
             ( (isIPv4(address) && (prefix < 32))  ||
               (!isIPv4(address) && (prefix < 128)) ) ) {
-      os << format(gettext("%s is a NETWORK address"), addressString);
+      os << format(outputLabel(OL_IsNetworkFormat).c_str(), addressString);
    }
    else {
       char networkString[64];
       address2string(&network.sa, networkString, sizeof(networkString), false, false);
-      os << format(gettext("%s is a HOST address in %s/%u"),
+      os << format(outputLabel(OL_IsHostFormat).c_str(),
                    addressString, networkString, prefix);
    }
    os << "\n";
 
 
    // ====== IPv4 properties ================================================
+   const unsigned int properties = getAddressProperties(address);
    if(isIPv4(address)) {
       const in_addr_t    ipv4address = ntohl(getIPv4Address(address));
       const unsigned int a           = ipv4address >> 24;
       const unsigned int b           = (ipv4address & 0x00ff0000) >> 16;
 
-      if(IN_CLASSA(ipv4address)) {
-         os << "   - " << gettext("Class A") << "\n";
-         if(ipv4address == INADDR_LOOPBACK) {
-            os << "   - " << gettext("Loopback address") << "\n";
+      if(properties & AP_ClassA) {
+         os << outputLabel(OL_ClassA);
+         if(properties & AP_Loopback) {
+            os << outputLabel(OL_Loopback);
          }
-         else if(a == IN_LOOPBACKNET) {
-            os << "   - " << gettext("In loopback network") << "\n";
+         else if(properties & AP_LoopbackNetwork) {
+            os << outputLabel(OL_LoopbackNetwork);
          }
-         else if(a == 10) {
-            os << "   - " << gettext("Private") << "\n";
+         else if(properties & AP_Private) {
+            os << outputLabel(OL_Private);
          }
       }
-      else if(IN_CLASSB(ipv4address)) {
-         os << "   - " << gettext("Class B") << "\n";
-         if((a == 172) && ((b >= 16) && (b <= 31))) {
-            os << "   - " << gettext("Private") << "\n";
+      else if(properties & AP_ClassB) {
+         os << outputLabel(OL_ClassB);
+         if(properties & AP_Private) {
+            os << outputLabel(OL_Private);
          }
-         else if((a == 169) && (b == 254)) {
-            os << "   - " << gettext("Link-local address") << "\n";
+         else if(properties & AP_LinkLocal) {
+            os << outputLabel(OL_LinkLocal);
          }
       }
-      else if(IN_CLASSC(ipv4address)) {
-         os << "   - " << gettext("Class C") << "\n";
-         if((a == 192) && (b == 168)) {
-            os << "   - " << gettext("Private") << "\n";
+      else if(properties & AP_ClassC) {
+         os << outputLabel(OL_ClassC);
+         if(properties & AP_Private) {
+            os << outputLabel(OL_Private);
          }
       }
-      else if(IN_CLASSD(ipv4address)) {
-         os << "   - " << gettext("Class D (Multicast)") << "\n";
+      else if(properties & AP_ClassD) {
+         os << outputLabel(OL_ClassD);
          // ------ Multicast scope ------------------------------------------
-         os << "      + " << gettext("Scope: ");
          if(a == 224) {
-            os << gettext("link-local");
+            os << outputLabel(OL_ScopeLinkLocal);
          }
          else if((a == 239) && (b >= 192) && (b <= 251)) {
-            os << gettext("organization-local");
+            os << outputLabel(OL_ScopeOrganisationLocal);
          }
          else if((a == 239) && (b >= 252) && (b <= 255)) {
-            os << gettext("site-local");
+            os << outputLabel(OL_ScopeSiteLocal);
          }
          else {
-            os << gettext("global");
+            os << outputLabel(OL_ScopeGlobal);
          }
-         os << "\n";
 
          // ------ Corresponding MAC address --------------------------------
-         char macAddressString[32];
-         snprintf(macAddressString, sizeof(macAddressString),
-                  "01:00:5e:%02x:%02x:%02x",
-                  (ipv4address & 0x007f0000) >> 16,
-                  (ipv4address & 0x0000ff00) >> 8,
-                  (ipv4address & 0x000000ff));
-         os << "      + " << format(gettext("Corresponding multicast MAC address: %s"),
-                                    macAddressString) << "\n";
+         const AddressValue group { 0, ipv4address };
+         os << format(outputLabel(OL_MulticastMACFormat).c_str(),
+                      macAddressToString(multicastMAC(AF_INET, group)).c_str());
 
          // ------ Source-specific multicast --------------------------------
-         if(a == 232) {
-            os << "      + " << gettext("Source-specific multicast") << "\n";
+         if(properties & AP_SourceSpecific) {
+            os << outputLabel(OL_SourceSpecific);
          }
       }
       else {
-         os << "   - " << gettext("Invalid (not in class A, B, C or D)") << "\n";
+         os << outputLabel(OL_InvalidClass);
       }
    }
 
@@ -624,128 +467,123 @@ void printAddressProperties(std::ostream&         os,
    else {
       const in6_addr ipv6address = getIPv6Address(address);
       const uint16_t word0       = (ipv6address.s6_addr[0] << 8) | ipv6address.s6_addr[1];
-      const uint16_t word1       = (ipv6address.s6_addr[2] << 8) | ipv6address.s6_addr[3];
-      const uint16_t word5       = (ipv6address.s6_addr[10] << 8) | ipv6address.s6_addr[11];
       const uint16_t word6       = (ipv6address.s6_addr[12] << 8) | ipv6address.s6_addr[13];
       const uint16_t word7       = (ipv6address.s6_addr[14] << 8) | ipv6address.s6_addr[15];
 
       // ------ Special addresses -------------------------------------------
-      if(IN6_IS_ADDR_LOOPBACK(&ipv6address)) {
-         os << "   - " << gettext("Loopback address") << "\n";
+      if(properties & AP_Loopback) {
+         os << outputLabel(OL_Loopback);
       }
-      else if(IN6_IS_ADDR_UNSPECIFIED(&ipv6address)) {
-         os << "   - " << gettext("Unspecified address") << "\n";
+      else if(properties & AP_Unspecified) {
+         os << outputLabel(OL_Unspecified);
       }
-      else if(IN6_IS_ADDR_V4COMPAT(&ipv6address)) {
-         os << "   - " << gettext("IPv4-compatible IPv6 address") << "\n";
+      else if(properties & AP_IPv4Compatible) {
+         os << outputLabel(OL_IPv4Compatible);
       }
-      else if(IN6_IS_ADDR_V4MAPPED(&ipv6address)) {
-         os << "   - " << gettext("IPv4-mapped IPv6 address") << "\n";
+      else if(properties & AP_IPv4Mapped) {
+         os << outputLabel(OL_IPv4Mapped);
       }
-      else if(hasTranslationPrefix(&address.in6)) {
-         os << "   - " << gettext("IPv4-embedded IPv6 address") << "\n";
+      else if(properties & AP_IPv4Embedded) {
+         os << outputLabel(OL_IPv4Embedded);
+         in_addr embeddedAddress;
+         char    embeddedAddressString[INET_ADDRSTRLEN];
+         if( (extractIPv4Address(ipv6address, getTranslationPrefixLength(&address.in6),
+                                 embeddedAddress)) &&
+             (inet_ntop(AF_INET, &embeddedAddress, embeddedAddressString,
+                        sizeof(embeddedAddressString)) != nullptr) ) {
+            os << format(outputLabel(OL_EmbeddedIPv4Format).c_str(),
+                         embeddedAddressString);
+         }
       }
 
       // ------ Multicast addresses -----------------------------------------
-      else if(IN6_IS_ADDR_MULTICAST(&ipv6address)) {
+      else if(properties & AP_Multicast) {
          // ------ Multicast scope ------------------------------------------
-         os << "   - " << gettext("Multicast Properties") << "\n";
-         os << "      + " << gettext("Scope: ");
+         os << outputLabel(OL_MulticastProperties);
          if(IN6_IS_ADDR_MC_NODELOCAL(&ipv6address)) {
-            os << gettext("node-local");
+            os << outputLabel(OL_ScopeNodeLocal);
          }
          else if(IN6_IS_ADDR_MC_LINKLOCAL(&ipv6address)) {
-            os << gettext("link-local");
+            os << outputLabel(OL_ScopeLinkLocal);
          }
          else if(IN6_IS_ADDR_MC_SITELOCAL(&ipv6address)) {
-            os << gettext("site-local");
+            os << outputLabel(OL_ScopeSiteLocal);
          }
          else if(IN6_IS_ADDR_MC_ORGLOCAL(&ipv6address)) {
-            os << gettext("organization-local");
+            os << outputLabel(OL_ScopeOrganisationLocal);
          }
          else if(IN6_IS_ADDR_MC_GLOBAL(&ipv6address)) {
-            os << gettext("global");
+            os << outputLabel(OL_ScopeGlobal);
          }
          else {
-            os << gettext("unknown");
+            os << outputLabel(OL_ScopeUnknown);
          }
-         os << "\n";
 
          // ------ Multicast flags ------------------------------------------
          const uint8_t flags = (ipv6address.s6_addr[1] & 0xf0) >> 4;
          if(flags == 0x1) {
-            os << "      + " << gettext("Temporarily-allocated address") << "\n";
+            os << outputLabel(OL_TemporarilyAllocated);
          }
 
          // ------ Corresponding MAC address --------------------------------
-         char macAddressString[32];
-         snprintf(macAddressString, sizeof(macAddressString),
-                  "33:33:%02x:%02x:%02x:%02x",
-                  ipv6address.s6_addr[12],
-                  ipv6address.s6_addr[13],
-                  ipv6address.s6_addr[14],
-                  ipv6address.s6_addr[15]);
-         os << "      + " << format(gettext("Corresponding multicast MAC address: %s"),
-                                    macAddressString) << "\n";
+         AddressValue group;
+         addressToValue(address, group);
+         os << format(outputLabel(OL_MulticastMACFormat).c_str(),
+                      macAddressToString(multicastMAC(AF_INET6, group)).c_str());
 
          // ------ Source-specific multicast --------------------------------
-         if( ((word0 & 0xfff0) == 0xff30) && (word1 == 0x0000) ) {
-            // FF0x:0::/32
-            os << "      + " << gettext("Source-specific multicast") << "\n";
+         if(properties & AP_SourceSpecific) {
+            os << outputLabel(OL_SourceSpecific);
          }
 
          // ------ Solicited node multicast address -------------------------
-         // FF02::1:FF00:0/104
-         if( (word0 == 0xff02) &&
-             (word5 == 0x0001) &&
-             ((word6 & 0xff00) == 0xff00) ) {
+         if(properties & AP_SolicitedNode) {
             char nodeAddressString[64];
             snprintf(nodeAddressString, sizeof(nodeAddressString),
                      "xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xx%02x:%04x",
                      word6 & 0xff, word7);
-            os << "      + " << gettext("Address is solicited node multicast address for")
-               << " " << nodeAddressString << "\n";
+            os << outputLabel(OL_SolicitedNodeFor) << nodeAddressString << "\n";
          }
       }
 
       // ------ Link-local Unicast ------------------------------------------
-      else if(IN6_IS_ADDR_LINKLOCAL(&ipv6address)) {
-         os << "   - " << gettext("Link-Local Unicast Properties:") << "\n";
-         printUnicastProperties(std::cout, ipv6address, colourMode, false, false);
+      else if(properties & AP_LinkLocal) {
+         os << outputLabel(OL_LinkLocalUnicast);
+         printUnicastProperties(os, ipv6address, colourMode, false, false);
       }
 
       // ------ Site-Local Unicast ------------------------------------------
-      else if(IN6_IS_ADDR_SITELOCAL(&ipv6address)) {
-         os << "   - " << gettext("Site-Local Unicast Properties:") << "\n";
-         printUnicastProperties(std::cout, ipv6address, colourMode, true, false);
+      else if(properties & AP_SiteLocal) {
+         os << outputLabel(OL_SiteLocalUnicast);
+         printUnicastProperties(os, ipv6address, colourMode, true, false);
       }
 
       // ------ Unique Local Unicast ----------------------------------------
-      else if((word0 & 0xfc00) == 0xfc00) {
-         os << "   - " << gettext("Unique Local Unicast Properties:") << "\n";
+      else if(properties & AP_UniqueLocal) {
+         os << outputLabel(OL_UniqueLocalUnicast);
          if(word0 & 0x0100) {
-            os << "      + " << gettext("Locally chosen") << "\n";
+            os << outputLabel(OL_LocallyChosen);
          }
          else {
-            os << "      + " << gettext("Assigned by global instance") << "\n";
+            os << outputLabel(OL_AssignedByGlobalInstance);
          }
-         printUnicastProperties(std::cout, ipv6address, colourMode, true, true);
+         printUnicastProperties(os, ipv6address, colourMode, true, true);
       }
 
       // ------ Global Unicast ----------------------------------------------
-      else if((word0 & 0xe000) == 0x2000) {
-         os << "   - " << gettext("Global Unicast Properties:") << "\n";
-         printUnicastProperties(std::cout, ipv6address, colourMode, false, false);
+      else if(properties & AP_GlobalUnicast) {
+         os << outputLabel(OL_GlobalUnicast);
+         printUnicastProperties(os, ipv6address, colourMode, false, false);
 
          // ------ 6to4 Address ---------------------------------------------
-         if((word0 & 0x2002) == 0x2002) {
+         if(properties & AP_6to4) {
             sockaddr_union sixToFour;
             sixToFour.sa.sa_family       = AF_INET;
             const uint32_t u = (ipv6address.s6_addr[2] << 8) | ipv6address.s6_addr[3];
             const uint32_t l = (ipv6address.s6_addr[4] << 8) | ipv6address.s6_addr[5];
             sixToFour.in.sin_addr.s_addr = htonl((u << 16) | l);
-            os << "      + " << format("%-32s = ", gettext("6-to-4 Address"));
-            printAddress(std::cout, &sixToFour.sa, false);
+            os << outputLabel(OL_6to4Address);
+            printAddress(os, &sixToFour.sa, false);
             os << "\n";
          }
       }
@@ -767,172 +605,43 @@ std::string toString(unsigned __int128 num) {
 #endif
 
 
-#ifdef HAVE_MAXMINDDB
-// ###### Find location of MaxMindDB .mmdb file #############################
-std::string find_mmdb_path(const std::string& mmdbFileName) {
-   static const std::vector<std::string> mmdbDirectories = {
-      "/usr/share/GeoIP",          // Debian, Ubuntu
-      "/var/lib/GeoIP",            // CentOS, Fedora, RedHat
-      "/usr/local/share/GeoIP",    // FreeBSD
-      "/opt/homebrew/var/GeoIP",   // MacOS (Homebrew Apple Silicon)
-      "/usr/local/var/GeoIP",      // MacOS (Homebrew Intel)
-      "/etc/GeoIP"                 // Legacy
-   };
-
-   for (const auto& directory : mmdbDirectories) {
-      const std::filesystem::path absolutePath =
-         std::filesystem::path(directory) / mmdbFileName;
-      if(std::filesystem::exists(absolutePath)) {
-         return absolutePath.string();
-      }
-    }
-    return "";
-}
-#endif
-
-
-// ###### Version ###########################################################
-#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 202000L)
-[[ noreturn ]]
-#endif
-static void version(void)
-{
-   std::cout << "SubNetCalc " << SUBNETCALC_VERSION << "\n";
-   exit(0);
-}
-
-
-// ###### Usage #############################################################
-#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 202000L)
-[[ noreturn ]]
-#endif
-static void usage(const char* program, const int exitCode)
-{
-   std::cerr << gettext("Usage:") << " "
-             << program
-             << " address/prefix | address/netmask | address [prefix] | address [netmask]\n"
-                " [-u|--uniquelocal] [-U|--uniquelocalhq]\n"
-                " [-n|--noreverselookup]\n"
-                " [-g|--nogeoiplookup]\n"
-                " [-c|--nocolour|--nocolor]\n"
-                " [-h|--help] [-v|--version]\n";
-   exit(exitCode);
-}
-
-
-// ###### Main program ######################################################
-int main(int argc, char** argv)
+// ###### Read address and netmask or prefix from arguments ################
+static bool readAddressArguments(std::ostream&   errorStream,
+                                 std::string     argument1,
+                                 const char*     argument2,
+                                 sockaddr_union& address,
+                                 sockaddr_union& netmask,
+                                 int&            prefix)
 {
-   // ====== Initialise i18n support ========================================
-   if(setlocale(LC_ALL, "") == nullptr) {
-      setlocale(LC_ALL, "C.UTF-8");   // "C" should exist on all systems!
-   }
-   bindtextdomain("subnetcalc", nullptr);
-   textdomain("subnetcalc");
-
-   // ====== Handle arguments ===============================================
-   static const struct option long_options[] = {
-      { "uniquelocal",     no_argument, 0, 'u' },
-      { "uniquelocalhq",   no_argument, 0, 'U' },
-      { "nocolour",        no_argument, 0, 'c' },
-      { "nocolor",         no_argument, 0, 'c' },
-      { "noreverselookup", no_argument, 0, 'n' },
-      { "nogeoiplookup",   no_argument, 0, 'g' },
-      { "help",            no_argument, 0, 'h' },
-      { "version",         no_argument, 0, 'v' },
-      {  nullptr,          0,           0, 0   }
-   };
-
-   bool         colourMode      = true;
-   bool         noReverseLookup = false;
-   bool         noGeoIPLookup   = false;
-   unsigned int uniqueLocal     = 0;
-   int option;
-   int longIndex;
-   while( (option = getopt_long_only(argc, argv, "uUcnghv", long_options, &longIndex)) != -1 ) {
-      switch(option) {
-         case 'n':
-            noReverseLookup = true;
-            break;
-         case 'g':
-            noGeoIPLookup = true;
-            break;
-         case 'c':
-            colourMode = false;
-            break;
-         case 'u':
-            uniqueLocal = 1;
-            break;
-         case 'U':
-            uniqueLocal = 2;
-            break;
-         case 'v':
-            version();
-            break;
-         case 'h':
-         case '?':
-            // Exit with 0 on h/help, exit with 1 on '?' (unknown option):
-            usage(argv[0], (option == 'h') ? 0 : 1);
-            break;
-         case '-':
-            break;
-         default:
-            // This should not happen: wrong getopt parameters, or missing case?
-            fprintf(stderr, "INTERNAL ERROR: Unhandled option c=%c code=%x!\n",
-                    (isprint(option) ? (char)option : ' '), option);
-            return 1;
-      }
-   }
-   if( (optind + 1 != argc) && (optind + 2 != argc) ) {
-      usage(argv[0], 1);
-   }
-
-   int                prefix;
-   unsigned int       hostBits;
-   unsigned int       reservedHosts;
-#if defined(__SIZEOF_INT128__)
-   unsigned __int128  maxHosts;
-#else
-   // There is no 128-bit type on 32-bit systems!
-   unsigned long long maxHosts;
-#endif
-   sockaddr_union     network;
-   sockaddr_union     address;
-   sockaddr_union     netmask;
-   sockaddr_union     broadcast;
-   sockaddr_union     wildcard;
-   sockaddr_union     host1;
-   sockaddr_union     host2;
-
    // ====== Get address and netmask from one parameter =====================
-   char* slash = strchr(argv[optind], '/');
+   char* slash = strchr(argument1.data(), '/');
    if(slash) {
       slash[0] = 0x00;
-      if(string2address(argv[optind], &address) == false) {
-         std::cerr << format(gettext("ERROR: Invalid address %s!"), argv[optind]) << "\n";
-         exit(1);
+      if(string2address(argument1.data(), &address) == false) {
+         errorStream << format(gettext("ERROR: Invalid address %s!"), argument1.data()) << "\n";
+         return false;
       }
       if(readPrefix(&slash[1], address, netmask) < 0) {
          if(string2address(&slash[1], &netmask) == false) {
-            std::cerr << format(gettext("ERROR: Invalid netmask %s!"), argv[optind]) << "\n";
-            exit(1);
+            errorStream << format(gettext("ERROR: Invalid netmask %s!"), argument1.data()) << "\n";
+            return false;
          }
       }
    }
 
    // ====== Get address and netmask from separate parameters ===============
    else if(slash == nullptr) {
-      if(string2address(argv[optind], &address) == false) {
-         std::cerr << format(gettext("ERROR: Invalid address %s!"), argv[optind]) << "\n";
-         exit(1);
+      if(string2address(argument1.data(), &address) == false) {
+         errorStream << format(gettext("ERROR: Invalid address %s!"), argument1.data()) << "\n";
+         return false;
       }
-      if(optind + 1 < argc) {
+      if(argument2 != nullptr) {
          // ------ Get netmask or prefix ------------------------------------
-         if(argv[optind + 1][0] != '-') {
-            if( readPrefix(argv[optind + 1], address, netmask) < 0 ) {
-               if(string2address(argv[optind + 1], &netmask) == false) {
-                  std::cerr << format(gettext("ERROR: Invalid netmask %s!"), argv[optind + 1]) << "\n";
-                  exit(1);
+         if(argument2[0] != '-') {
+            if( readPrefix(argument2, address, netmask) < 0 ) {
+               if(string2address(argument2, &netmask) == false) {
+                  errorStream << format(gettext("ERROR: Invalid netmask %s!"), argument2) << "\n";
+                  return false;
                }
             }
          }
@@ -955,51 +664,59 @@ int main(int argc, char** argv)
    if(prefix < 0) {
       char addressString[64];
       address2string(&netmask.sa, addressString, sizeof(addressString), false, false);
-      std::cerr << format(gettext("ERROR: Invalid netmask %s!"), addressString) << "\n";
-      exit(1);
+      errorStream << format(gettext("ERROR: Invalid netmask %s!"), addressString) << "\n";
+      return false;
    }
    if(netmask.sa.sa_family != address.sa.sa_family) {
       char addressString[64];
       address2string(&netmask.sa, addressString, sizeof(addressString), false, false);
-      std::cerr << format(gettext("ERROR: Incompatible netmask %s!"), addressString) << "\n";
-      exit(1);
+      errorStream << format(gettext("ERROR: Incompatible netmask %s!"), addressString) << "\n";
+      return false;
    }
 
+   return true;
+}
 
-   // ====== Unique Local IPv4 address generation ===========================
-   if(uniqueLocal > 0) {
-      generateUniqueLocal(address, (uniqueLocal > 1));
-   }
 
+// ###### Print subnet information ##########################################
+static void printSubnet(std::ostream&          os,
+                        const sockaddr_union&  address,
+                        const sockaddr_union&  netmask,
+                        const int              prefix,
+                        const bool             colourMode,
+                        const bool             noReverseLookup,
+                        const bool             noGeoIPLookup,
+                        const AnnotationIndex* annotations)
+{
+   unsigned int       hostBits;
+   unsigned int       reservedHosts;
+#if defined(__SIZEOF_INT128__)
+   unsigned __int128  maxHosts;
+#else
+   // There is no 128-bit type on 32-bit systems!
+   unsigned long long maxHosts;
+#endif
+   sockaddr_union     network;
+   sockaddr_union     broadcast;
+   sockaddr_union     wildcard;
+   sockaddr_union     host1;
+   sockaddr_union     host2;
 
    // ====== Calculate network address, hosts, etc. =========================
-   network   = address & netmask;
-   broadcast = network | (~netmask);
-   wildcard  = ~netmask;
-   if(isIPv4(address)) {
-      reservedHosts = 2;
-      hostBits      = 32 - prefix;
-      host1         = network + 1;
-      host2         = broadcast - 1;
-      if(prefix >= 31) {   // Special case for Point-to-Point links
-         reservedHosts = 0;
-         host1 = network;
-         host2 = broadcast;
-      }
-   }
-   else {
-      reservedHosts = 1;
-      hostBits      = 128 - prefix;
-      if(prefix < 128) {
-         host1    = network + 1;
-         host2    = broadcast;   // There is no broadcast address for IPv6!
-      }
-      else {
-         reservedHosts = 0;
-         host1         = network;
-         host2         = broadcast;   // There is no broadcast address for IPv6!
-      }
-   }
+   // Special case for IPv4 Point-to-Point links: /31 and /32.
+   // There is no broadcast address for IPv6!
+   Prefix subnet;
+   makePrefix(address, prefix, subnet);
+   const AddressValue last = lastAddress(subnet);
+   reservedHosts = ::reservedHosts(subnet);
+   hostBits      = familyBits(subnet.family) - prefix;
+   network       = replaceAddress(address, subnet.network);
+   broadcast     = replaceAddress(address, last);
+   wildcard      = replaceAddress(netmask, hostMask(subnet.family, prefix));
+   host1         = replaceAddress(address, (reservedHosts > 0) ?
+                                              increment(subnet.network) : subnet.network);
+   host2         = replaceAddress(address, (reservedHosts == 2) ? decrement(last) : last);
+
 #if defined(__SIZEOF_INT128__)
    maxHosts = (unsigned __int128)pow(2.0, (double)hostBits) - reservedHosts;
 #else
@@ -1013,34 +730,28 @@ int main(int argc, char** argv)
 
 
    // ====== Print results ==================================================
-   std::cout << format(gettext("%-14s"), gettext("Address")) << " = "
-             << address << "\n";
-   printAddressBinary(std::cout, address, prefix, colourMode,
-                      (format(gettext("%-14s"), " ") + "      ").c_str());
-   std::cout << format(gettext("%-14s"), gettext("Network")) << " = "
-             << network << " / " << prefix << "\n"
-             << format(gettext("%-14s"), gettext("Netmask")) << " = "
-             << netmask << "\n";
+   os << outputLabel(OL_Address) << address << "\n";
+   printAddressBinary(os, address, prefix, colourMode,
+                      outputLabel(OL_BinaryIndent).c_str());
+   os << outputLabel(OL_Network) << network << " / " << prefix << "\n"
+      << outputLabel(OL_Netmask) << netmask << "\n";
    if(isIPv4(address)) {
-      std::cout << format(gettext("%-14s"), gettext("Broadcast")) << " = ";
+      os << outputLabel(OL_Broadcast);
       if(reservedHosts == 2) {
-         std::cout << broadcast;
+         os << broadcast;
       }
       else {
-         std::cout << gettext("not needed on Point-to-Point links");
+         os << outputLabel(OL_NotNeededOnPointToPoint);
       }
-      std::cout << "\n";
+      os << "\n";
    }
-   std::cout << format(gettext("%-14s"), gettext("Wildcard Mask"))
-             << " = " << wildcard << "\n";
+   os << outputLabel(OL_WildcardMask) << wildcard << "\n";
    if(isIPv4(address)) {
       char hex[16];
       snprintf(hex, sizeof(hex), "%08X", ntohl(address.in.sin_addr.s_addr));
-      std::cout << format(gettext("%-14s"), gettext("Hex. Address"))
-                << " = " << hex << "\n";
+      os << outputLabel(OL_HexAddress) << hex << "\n";
    }
-   std::cout << format(gettext("%-14s"), gettext("Host Bits")) << " = "
-             << hostBits << "\n";
+   os << outputLabel(OL_HostBits) << hostBits << "\n";
    if(!isMulticast(address)) {
       char maxHostsString[128];
       if(maxHosts > 0) {
@@ -1056,137 +767,143 @@ int main(int argc, char** argv)
          snprintf(maxHostsString, sizeof(maxHostsString),
                   "2^%u - %u", hostBits, reservedHosts);
       }
-      std::cout << format(gettext("%-14s"), gettext("Max. Hosts")) << " = "
-                << maxHostsString << "\n"
-                << format(gettext("%-14s"), gettext("Host Range")) << " = { "
-                << host1 << " - " << host2 << " }" << "\n";
+      os << outputLabel(OL_MaxHosts) << maxHostsString << "\n"
+         << outputLabel(OL_HostRange) << "{ " << host1 << " - " << host2 << " }" << "\n";
    }
 
 
    // ====== Properties =====================================================
-   printAddressProperties(std::cout, address, netmask, prefix, network, broadcast, colourMode);
+   printAddressProperties(os, address, netmask, prefix, network, broadcast, colourMode);
 
 
    // ====== GeoIP ==========================================================
 #ifdef HAVE_MAXMINDDB
-   MMDB_s               mmdb;
    MMDB_lookup_result_s mmdbLookupResult;
    MMDB_entry_data_s    mmdbEntryData;
    int                  mmdbErrorCode;
-   int                  mmdbStatusCode;
 
    // ------ ASN Lookup -----------------------------------------------------
    if(!noGeoIPLookup) {
-      const std::string mmdbASNDatabasePath = find_mmdb_path("GeoLite2-ASN.mmdb");
-      if(!mmdbASNDatabasePath.empty()) {
-         mmdbStatusCode = MMDB_open(mmdbASNDatabasePath.c_str(), MMDB_MODE_MMAP, &mmdb);
-         if(mmdbStatusCode == MMDB_SUCCESS) {
-            mmdbLookupResult = MMDB_lookup_sockaddr(&mmdb, &address.sa, &mmdbErrorCode);
-            if(mmdbLookupResult.found_entry) {
-               std::string organisation = gettext("Unknown");
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "autonomous_system_organization", nullptr) == MMDB_SUCCESS) &&
-                   (mmdbEntryData.has_data) ) {
-                  organisation = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
-               }
-               std::cout << format("%-14s = ", gettext("GeoIP AS Info")) << organisation << "\n";
+      MMDB_s* mmdb = openGeoIPDatabase("GeoLite2-ASN.mmdb");
+      if(mmdb != nullptr) {
+         mmdbLookupResult = MMDB_lookup_sockaddr(mmdb, &address.sa, &mmdbErrorCode);
+         if(mmdbLookupResult.found_entry) {
+            std::string organisation = outputLabel(OL_Unknown);
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "autonomous_system_organization", nullptr) == MMDB_SUCCESS) &&
+                (mmdbEntryData.has_data) ) {
+               organisation = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
             }
-            MMDB_close(&mmdb);
+            os << outputLabel(OL_GeoIPASInfo) << organisation << "\n";
          }
       }
    }
 
    // ------ Country and City Lookup ----------------------------------------
    if(!noGeoIPLookup) {
-      const std::string mmdbCityDatabasePath = find_mmdb_path("GeoLite2-City.mmdb");
-      if(!mmdbCityDatabasePath.empty()) {
-         mmdbStatusCode = MMDB_open(mmdbCityDatabasePath.c_str(), MMDB_MODE_MMAP, &mmdb);
-         if(mmdbStatusCode == MMDB_SUCCESS) {
-            mmdbLookupResult = MMDB_lookup_sockaddr(&mmdb, &address.sa, &mmdbErrorCode);
-            if(mmdbLookupResult.found_entry) {
-
-               // ------ Country --------------------------------------------
-               std::string country = gettext("Unknown");
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "country", "names", "en", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  country = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
-               }
-
-               std::string code = "??";
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "country", "iso_code", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  code = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
-               }
+      MMDB_s* mmdb = openGeoIPDatabase("GeoLite2-City.mmdb");
+      if(mmdb != nullptr) {
+         mmdbLookupResult = MMDB_lookup_sockaddr(mmdb, &address.sa, &mmdbErrorCode);
+         if(mmdbLookupResult.found_entry) {
+
+            // ------ Country -----------------------------------------------
+            std::string country = outputLabel(OL_Unknown);
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "country", "names", "en", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               country = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
+            }
 
-               std::cout << format("%-14s = ", gettext("GeoIP Country"))
-                        << country << " (" << code << ")\n";
+            std::string code = "??";
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "country", "iso_code", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               code = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
+            }
 
-               // ------ Region and City ------------------------------------
-               std::string postalCode;
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "postal", "code", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  postalCode = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
-               }
+            os << outputLabel(OL_GeoIPCountry)
+               << country << " (" << code << ")\n";
 
-               std::string city = gettext("Unknown");
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "city", "names", "en", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  city = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
-               }
+            // ------ Region and City ---------------------------------------
+            std::string postalCode;
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "postal", "code", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               postalCode = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
+            }
 
-               std::string region = gettext("Unknown");
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "subdivisions", "0", "names", "en", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  region = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
-               }
+            std::string city = outputLabel(OL_Unknown);
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "city", "names", "en", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               city = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
+            }
 
-               std::string timeZone;
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "location", "time_zone", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  timeZone = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
-               }
+            std::string region = outputLabel(OL_Unknown);
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "subdivisions", "0", "names", "en", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               region = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
+            }
 
-               double latitude = 0.0;
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "location", "latitude", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  latitude = mmdbEntryData.double_value;
-               }
+            std::string timeZone;
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "location", "time_zone", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               timeZone = std::string(mmdbEntryData.utf8_string, mmdbEntryData.data_size);
+            }
 
-               double longitude = 0.0;
-               if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
-                                 "location", "longitude", nullptr) == MMDB_SUCCESS) &&
-                  (mmdbEntryData.has_data) ) {
-                  longitude = mmdbEntryData.double_value;
-               }
+            double latitude = 0.0;
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "location", "latitude", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               latitude = mmdbEntryData.double_value;
+            }
 
-               std::cout << format("%-14s = ", gettext("GeoIP Region"))
-                        << postalCode << (!postalCode.empty() ? " " : "")
-                        << city << ", " << region
-                        << " ("
-                        << std::fabs(latitude)  << "°" << ((latitude >= 0.0)  ? "N" : "S") << ", "
-                        << std::fabs(longitude) << "°" << ((longitude >= 0.0) ? "E" : "W")
-                        << (!timeZone.empty() ? ", " : "") << timeZone
-                        << ")\n";
+            double longitude = 0.0;
+            if( (MMDB_get_value(&mmdbLookupResult.entry, &mmdbEntryData,
+                              "location", "longitude", nullptr) == MMDB_SUCCESS) &&
+               (mmdbEntryData.has_data) ) {
+               longitude = mmdbEntryData.double_value;
             }
-            MMDB_close(&mmdb);
+
+            os << outputLabel(OL_GeoIPRegion)
+               << postalCode << (!postalCode.empty() ? " " : "")
+               << city << ", " << region
+               << " ("
+               << std::fabs(latitude)  << "°" << ((latitude >= 0.0)  ? "N" : "S") << ", "
+               << std::fabs(longitude) << "°" << ((longitude >= 0.0) ? "E" : "W")
+               << (!timeZone.empty() ? ", " : "") << timeZone
+               << ")\n";
          }
       }
    }
 #endif
 
 
+   // ====== Site-specific annotations ======================================
+   if(annotations != nullptr) {
+      AddressValue value;
+      addressToValue(address, value);
+      const uint32_t record = annotations->lookup(address.sa.sa_family, value);
+      if(record != AnnotationIndex::NoRecord) {
+         for(unsigned int column = 0; column < annotations->columns(); column++) {
+            const char* value = annotations->value(record, column);
+            if(value[0] != 0x00) {
+               os << format("%-14s", annotations->columnName(column)) << " = "
+                  << value << "\n";
+            }
+         }
+      }
+   }
+
+
    // ====== Reverse lookup =================================================
    if(noReverseLookup == false) {
+      initialiseI18N();   // IDN conversion depends on the locale's charset
       if(isatty(fileno(stdout))) {
-         std::cout << gettext("Performing reverse DNS lookup ...");
-         std::cout.flush();
+         os << outputLabel(OL_ReverseLookupInProgress);
+         os.flush();
       }
       char hostname[NI_MAXHOST];
       int error = getnameinfo(&address.sa,
@@ -1201,26 +918,784 @@ int main(int argc, char** argv)
 #endif
                              );
       if(isatty(fileno(stdout))) {
-         std::cout << "\r\x1b[K";
+         os << "\r\x1b[K";
       }
-      std::cout << format("%-14s = ", gettext("DNS Hostname"));
-      std::cout.flush();
+      os << outputLabel(OL_DNSHostname);
+      os.flush();
       if(error == 0) {
 #ifndef NI_IDN
          char* utf8hostname = nullptr;
          if(idn2_to_unicode_8z8z(hostname, &utf8hostname, 0) == IDN2_OK) {
-            std::cout << utf8hostname << "\n";
+            os << utf8hostname << "\n";
             idn2_free(utf8hostname);
          }
          else {
 #endif
-            std::cout << hostname << "\n";
+            os << hostname << "\n";
 #ifndef NI_IDN
          }
 #endif
       }
       else {
-         std::cout << "(" << gai_strerror(error) << ")" << "\n";
+         os << "(" << gai_strerror(error) << ")" << "\n";
+      }
+   }
+}
+
+
+// ###### Answer a query of the server mode #################################
+// The query contains the arguments of a standard invocation. Reverse DNS
+// lookups are not made, since they would block all other clients.
+static bool handleQuery(const std::string&     query,
+                        std::ostream&          response,
+                        bool                   noGeoIPLookup,
+                        const AnnotationIndex* annotations)
+{
+   std::istringstream       queryStream(query);
+   std::vector<std::string> arguments;
+   std::string              argument;
+   while(queryStream >> argument) {
+      if( (argument == "-g") || (argument == "--nogeoiplookup") ) {
+         noGeoIPLookup = true;
+      }
+      else if( (argument == "-n") || (argument == "--noreverselookup") ) {
+         // Reverse lookups are never made.
+      }
+      else if( (argument[0] == '-') && (argument.size() > 1) &&
+               (!isdigit(argument[1])) ) {
+         response << format(gettext("ERROR: Invalid query option %s!"), argument.c_str()) << "\n";
+         return false;
+      }
+      else {
+         arguments.push_back(argument);
+      }
+   }
+   if( (arguments.size() < 1) || (arguments.size() > 2) ) {
+      response << gettext("ERROR: A query needs an address and an optional netmask or prefix!") << "\n";
+      return false;
+   }
+
+   int            prefix;
+   sockaddr_union address;
+   sockaddr_union netmask;
+   if(!readAddressArguments(response, arguments[0],
+                            (arguments.size() > 1) ? arguments[1].c_str() : nullptr,
+                            address, netmask, prefix)) {
+      return false;
+   }
+   printSubnet(response, address, netmask, prefix, false, true, noGeoIPLookup,
+               annotations);
+   return true;
+}
+
+
+// ###### Options without short form #######################################
+enum LongOnlyOption {
+   OPT_FORMAT    = 0x100,
+   OPT_FREESPACE,
+   OPT_MINSIZE,
+   OPT_OVERLAPS,
+   OPT_SCAN,
+   OPT_IPV4PREFIX,
+   OPT_IPV6PREFIX,
+   OPT_COVERAGE,
+   OPT_DENSE,
+   OPT_INTERSECT,
+   OPT_BLOCKS,
+   OPT_GENERATE,
+   OPT_COUNT,
+   OPT_SAMPLE,
+   OPT_SEED,
+   OPT_REVERSE,
+   OPT_SLAAC,
+   OPT_EXTRACTMAC,
+   OPT_NAT64,
+   OPT_NSP,
+   OPT_SERVE,
+   OPT_DIFF,
+   OPT_STATS,
+   OPT_TREE,
+   OPT_ACL,
+   OPT_EXPAND,
+   OPT_RANGES,
+   OPT_GEOSTATS,
+   OPT_TOP,
+   OPT_COMPILE_ANNOTATIONS,
+   OPT_ANNOTATIONS,
+   OPT_MCASTMAC,
+   OPT_MCASTGROUPS,
+   OPT_COLLISIONS,
+   OPT_SOLICITED,
+   OPT_TABLESIZE,
+   OPT_RESOLVE,
+   OPT_NAMESERVER,
+   OPT_LIST_HOSTS
+};
+
+
+// ###### Read prefix length parameter of an option #########################
+static unsigned int readPrefixLengthOption(const char*        parameter,
+                                           const unsigned int maximum)
+{
+   if( (strlen(parameter) == 0) || (strlen(parameter) > 3) ||
+       (strspn(parameter, "0123456789") != strlen(parameter)) ||
+       ((unsigned int)atoi(parameter) > maximum) ) {
+      std::cerr << format(gettext("ERROR: Invalid prefix length %s!"), parameter) << "\n";
+      exit(1);
+   }
+   return (unsigned int)atoi(parameter);
+}
+
+
+// ###### Read numeric parameter of an option ##############################
+static unsigned long long readNumberOption(const char* parameter)
+{
+   errno = 0;
+   const unsigned long long value = strtoull(parameter, nullptr, 10);
+   if( (strlen(parameter) == 0) ||
+       (strspn(parameter, "0123456789") != strlen(parameter)) ||
+       (errno == ERANGE) ) {
+      std::cerr << format(gettext("ERROR: Invalid number %s!"), parameter) << "\n";
+      exit(1);
+   }
+   return value;
+}
+
+
+// ###### Version ###########################################################
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 202000L)
+[[ noreturn ]]
+#endif
+static void version(void)
+{
+   std::cout << "SubNetCalc " << SUBNETCALC_VERSION << "\n";
+   exit(0);
+}
+
+
+// ###### Usage #############################################################
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 202000L)
+[[ noreturn ]]
+#endif
+static void usage(const char* program, const int exitCode)
+{
+   std::cerr << gettext("Usage:") << " "
+             << program
+             << " address/prefix | address/netmask | address [prefix] | address [netmask]\n"
+                " [-u|--uniquelocal] [-U|--uniquelocalhq]\n"
+                " [-n|--noreverselookup]\n"
+                " [-g|--nogeoiplookup]\n"
+                " [--annotations index_file]\n"
+                " [-c|--nocolour|--nocolor]\n"
+                " [--nsp prefix]\n"
+                " [--freespace used_prefixes_file [--minsize prefix_length]]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --overlaps [label=]prefixes_file ...\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --coverage prefixes_file ...\n"
+                " [--intersect] [--dense] [--blocks prefix_length]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --diff old_prefixes_file new_prefixes_file\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --stats [label=]prefixes_file ...\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --tree prefixes_file ...\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --acl acl_file [--expand] [addresses_file]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --ranges addresses_file\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --geostats addresses_file [--top n]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --compile-annotations csv_file index_file\n"
+             << "       " << program
+             << " --mcastmac groups_file [--collisions]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --mcastgroups mac [address/prefix]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --resolve names_file [--nameserver address[:port]]\n"
+                " [--ipv4prefix prefix_length] [--ipv6prefix prefix_length]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --solicited addresses_file [--ipv6prefix prefix_length]\n"
+                " [--tablesize n] [--collisions]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --generate ula|iid|host [address/prefix] [--count n]\n"
+                " [-U|--uniquelocalhq]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --sample n address/prefix [--seed n]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --list-hosts address/prefix\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --reverse zone|ptr|cname address/prefix\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --slaac macs_file prefixes_file\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --extractmac addresses_file\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --nat64 addresses_file [--nsp prefix]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " --serve socket_path [-g|--nogeoiplookup] [--annotations index_file]\n"
+             << "       " << program
+             << " --query socket_path address/prefix | address/netmask | address [prefix] | address [netmask]\n"
+                " [-g|--nogeoiplookup]\n"
+             << "       " << program
+             << " --scan text_file\n"
+                " [--ipv4prefix prefix_length] [--ipv6prefix prefix_length]\n"
+                " [--format text|csv|json]\n"
+             << "       " << program
+             << " [-h|--help] [-v|--version]\n";
+   exit(exitCode);
+}
+
+
+// ###### Main program ######################################################
+int main(int argc, char** argv)
+{
+   // ====== Query client: answer before any initialisation =================
+   if( (argc >= 2) && (strcmp(argv[1], "--query") == 0) ) {
+      if(argc < 4) {
+         usage(argv[0], 1);
+      }
+      return runClient(argv[2], argc - 3, &argv[3]);
+   }
+
+   // ====== i18n support is initialised on first use (see tools.h) ========
+
+   // ====== Handle arguments ===============================================
+   static const struct option long_options[] = {
+      { "uniquelocal",         no_argument,       0, 'u'                     },
+      { "uniquelocalhq",       no_argument,       0, 'U'                     },
+      { "nocolour",            no_argument,       0, 'c'                     },
+      { "nocolor",             no_argument,       0, 'c'                     },
+      { "noreverselookup",     no_argument,       0, 'n'                     },
+      { "nogeoiplookup",       no_argument,       0, 'g'                     },
+      { "help",                no_argument,       0, 'h'                     },
+      { "version",             no_argument,       0, 'v'                     },
+      { "format",              required_argument, 0, OPT_FORMAT              },
+      { "freespace",           required_argument, 0, OPT_FREESPACE           },
+      { "minsize",             required_argument, 0, OPT_MINSIZE             },
+      { "overlaps",            no_argument,       0, OPT_OVERLAPS            },
+      { "scan",                required_argument, 0, OPT_SCAN                },
+      { "ipv4prefix",          required_argument, 0, OPT_IPV4PREFIX          },
+      { "ipv6prefix",          required_argument, 0, OPT_IPV6PREFIX          },
+      { "coverage",            no_argument,       0, OPT_COVERAGE            },
+      { "dense",               no_argument,       0, OPT_DENSE               },
+      { "intersect",           no_argument,       0, OPT_INTERSECT           },
+      { "blocks",              required_argument, 0, OPT_BLOCKS              },
+      { "generate",            required_argument, 0, OPT_GENERATE            },
+      { "count",               required_argument, 0, OPT_COUNT               },
+      { "sample",              required_argument, 0, OPT_SAMPLE              },
+      { "seed",                required_argument, 0, OPT_SEED                },
+      { "reverse",             required_argument, 0, OPT_REVERSE             },
+      { "slaac",               required_argument, 0, OPT_SLAAC               },
+      { "extractmac",          required_argument, 0, OPT_EXTRACTMAC          },
+      { "nat64",               required_argument, 0, OPT_NAT64               },
+      { "nsp",                 required_argument, 0, OPT_NSP                 },
+      { "serve",               required_argument, 0, OPT_SERVE               },
+      { "diff",                required_argument, 0, OPT_DIFF                },
+      { "stats",               no_argument,       0, OPT_STATS               },
+      { "tree",                no_argument,       0, OPT_TREE                },
+      { "acl",                 required_argument, 0, OPT_ACL                 },
+      { "expand",              no_argument,       0, OPT_EXPAND              },
+      { "ranges",              required_argument, 0, OPT_RANGES              },
+      { "geostats",            required_argument, 0, OPT_GEOSTATS            },
+      { "top",                 required_argument, 0, OPT_TOP                 },
+      { "compile-annotations", required_argument, 0, OPT_COMPILE_ANNOTATIONS },
+      { "mcastmac",            required_argument, 0, OPT_MCASTMAC            },
+      { "mcastgroups",         required_argument, 0, OPT_MCASTGROUPS         },
+      { "solicited",           required_argument, 0, OPT_SOLICITED           },
+      { "tablesize",           required_argument, 0, OPT_TABLESIZE           },
+      { "resolve",             required_argument, 0, OPT_RESOLVE             },
+      { "nameserver",          required_argument, 0, OPT_NAMESERVER          },
+      { "list-hosts",          no_argument,       0, OPT_LIST_HOSTS          },
+      { "collisions",          no_argument,       0, OPT_COLLISIONS          },
+      { "annotations",         required_argument, 0, OPT_ANNOTATIONS         },
+      {  nullptr,              0,                 0, 0                       }
+   };
+
+   bool               colourMode             = true;
+   bool               noReverseLookup        = false;
+   bool               noGeoIPLookup          = false;
+   unsigned int       uniqueLocal            = 0;
+   const char*        freeSpaceFile          = nullptr;
+   unsigned int       minSize                = 128;
+   bool               overlapsMode           = false;
+   const char*        scanFile               = nullptr;
+   unsigned int       ipv4PrefixLength       = 24;
+   unsigned int       ipv6PrefixLength       = 64;
+   bool               coverageMode           = false;
+   bool               dense                  = false;
+   bool               intersection           = false;
+   int                blockLength            = -1;
+   bool               generateFlag           = false;
+   GenerateMode       generateMode           = GM_UniqueLocal;
+   unsigned long long count                  = 1;
+   bool               sampleMode             = false;
+   unsigned long long sampleSize             = 0;
+   unsigned long long seed                   = 0;
+   bool               listHostsMode          = false;
+   bool               reverseFlag            = false;
+   ReverseMode        reverseMode            = RM_Zone;
+   const char*        slaacFile              = nullptr;
+   const char*        extractMACFile         = nullptr;
+   const char*        nat64File              = nullptr;
+   const char*        serveSocket            = nullptr;
+   const char*        diffFile               = nullptr;
+   bool               statsMode              = false;
+   bool               treeMode               = false;
+   const char*        aclFile                = nullptr;
+   bool               expand                 = false;
+   const char*        rangesFile             = nullptr;
+   const char*        geoStatsFile           = nullptr;
+   unsigned long long top                    = 10;
+   const char*        compileAnnotationsFile = nullptr;
+   const char*        mcastMACFile           = nullptr;
+   const char*        mcastGroupsMAC         = nullptr;
+   bool               collisions             = false;
+   const char*        solicitedFile          = nullptr;
+   const char*        resolveFile            = nullptr;
+   const char*        nameServer             = nullptr;
+   unsigned long long tableSize              = 1024;
+   const char*        annotationsFile        = nullptr;
+   Prefix             translationPrefix      = { { 0x0064ff9b00000000ULL, 0 }, AF_INET6, 96, 0 };
+   OutputFormat       outputFormat           = OF_Text;
+   int option;
+   int longIndex;
+   while( (option = getopt_long_only(argc, argv, "uUcnghv", long_options, &longIndex)) != -1 ) {
+      switch(option) {
+         case 'n':
+            noReverseLookup = true;
+            break;
+         case 'g':
+            noGeoIPLookup = true;
+            break;
+         case 'c':
+            colourMode = false;
+            break;
+         case 'u':
+            uniqueLocal = 1;
+            break;
+         case 'U':
+            uniqueLocal = 2;
+            break;
+         case 'v':
+            version();
+            break;
+         case OPT_FORMAT:
+            if(!parseOutputFormat(optarg, outputFormat)) {
+               std::cerr << format(gettext("ERROR: Invalid output format %s!"), optarg) << "\n";
+               exit(1);
+            }
+            break;
+         case OPT_OVERLAPS:
+            overlapsMode = true;
+            break;
+         case OPT_FREESPACE:
+            freeSpaceFile = optarg;
+            break;
+         case OPT_MINSIZE:
+            minSize = readPrefixLengthOption(optarg, 128);
+            break;
+         case OPT_SCAN:
+            scanFile = optarg;
+            break;
+         case OPT_IPV4PREFIX:
+            ipv4PrefixLength = readPrefixLengthOption(optarg, 32);
+            break;
+         case OPT_IPV6PREFIX:
+            ipv6PrefixLength = readPrefixLengthOption(optarg, 128);
+            break;
+         case OPT_COVERAGE:
+            coverageMode = true;
+            break;
+         case OPT_DENSE:
+            dense = true;
+            break;
+         case OPT_INTERSECT:
+            intersection = true;
+            break;
+         case OPT_BLOCKS:
+            blockLength = readPrefixLengthOption(optarg, 32);
+            break;
+         case OPT_GENERATE:
+            if(!parseGenerateMode(optarg, generateMode)) {
+               std::cerr << format(gettext("ERROR: Invalid generation mode %s!"), optarg) << "\n";
+               exit(1);
+            }
+            generateFlag = true;
+            break;
+         case OPT_COUNT:
+            count = readNumberOption(optarg);
+            break;
+         case OPT_SAMPLE:
+            sampleSize = readNumberOption(optarg);
+            sampleMode = true;
+            break;
+         case OPT_SEED:
+            seed = readNumberOption(optarg);
+            break;
+         case OPT_SLAAC:
+            slaacFile = optarg;
+            break;
+         case OPT_EXTRACTMAC:
+            extractMACFile = optarg;
+            break;
+         case OPT_SERVE:
+            serveSocket = optarg;
+            break;
+         case OPT_DIFF:
+            diffFile = optarg;
+            break;
+         case OPT_STATS:
+            statsMode = true;
+            break;
+         case OPT_TREE:
+            treeMode = true;
+            break;
+         case OPT_ACL:
+            aclFile = optarg;
+            break;
+         case OPT_EXPAND:
+            expand = true;
+            break;
+         case OPT_RANGES:
+            rangesFile = optarg;
+            break;
+         case OPT_GEOSTATS:
+            geoStatsFile = optarg;
+            break;
+         case OPT_TOP:
+            top = readNumberOption(optarg);
+            break;
+         case OPT_COMPILE_ANNOTATIONS:
+            compileAnnotationsFile = optarg;
+            break;
+         case OPT_ANNOTATIONS:
+            annotationsFile = optarg;
+            break;
+         case OPT_MCASTMAC:
+            mcastMACFile = optarg;
+            break;
+         case OPT_MCASTGROUPS:
+            mcastGroupsMAC = optarg;
+            break;
+         case OPT_COLLISIONS:
+            collisions = true;
+            break;
+         case OPT_RESOLVE:
+            resolveFile = optarg;
+            break;
+         case OPT_NAMESERVER:
+            nameServer = optarg;
+            break;
+         case OPT_LIST_HOSTS:
+            listHostsMode = true;
+            break;
+         case OPT_SOLICITED:
+            solicitedFile = optarg;
+            break;
+         case OPT_TABLESIZE:
+            tableSize = readNumberOption(optarg);
+            if( (tableSize < 1) || (tableSize > 0xffffffffULL) ) {
+               std::cerr << format(gettext("ERROR: Invalid number %s!"), optarg) << "\n";
+               exit(1);
+            }
+            break;
+         case OPT_NAT64:
+            nat64File = optarg;
+            break;
+         case OPT_NSP:
+            if( (!parsePrefix(optarg, translationPrefix)) ||
+                (translationPrefix.family != AF_INET6) ||
+                (!isTranslationPrefixLength(translationPrefix.length)) ) {
+               std::cerr << format(gettext("ERROR: Invalid translation prefix %s (length must be /32, /40, /48, /56, /64 or /96)!"), optarg) << "\n";
+               exit(1);
+            }
+            else {
+               sockaddr_union nsp;
+               valueToAddress(AF_INET6, translationPrefix.network, nsp);
+               setTranslationPrefix(nsp.in6.sin6_addr, translationPrefix.length);
+            }
+            break;
+         case OPT_REVERSE:
+            if(!parseReverseMode(optarg, reverseMode)) {
+               std::cerr << format(gettext("ERROR: Invalid reverse zone mode %s!"), optarg) << "\n";
+               exit(1);
+            }
+            reverseFlag = true;
+            break;
+         case 'h':
+         case '?':
+            // Exit with 0 on h/help, exit with 1 on '?' (unknown option):
+            usage(argv[0], (option == 'h') ? 0 : 1);
+            break;
+         case '-':
+            break;
+         default:
+            // This should not happen: wrong getopt parameters, or missing case?
+            fprintf(stderr, "INTERNAL ERROR: Unhandled option c=%c code=%x!\n",
+                    (isprint(option) ? (char)option : ' '), option);
+            return 1;
+      }
+   }
+
+   // ====== Only one mode can be used at once =============================
+   // The other options (e.g. -U with --generate) only modify a mode.
+   const unsigned int modes =
+      overlapsMode + coverageMode + statsMode + treeMode +
+      (aclFile != nullptr) + (rangesFile != nullptr) + (geoStatsFile != nullptr) +
+      (mcastMACFile != nullptr) + (mcastGroupsMAC != nullptr) +
+      (resolveFile != nullptr) + (solicitedFile != nullptr) +
+      (compileAnnotationsFile != nullptr) + (diffFile != nullptr) +
+      (slaacFile != nullptr) + (extractMACFile != nullptr) +
+      (nat64File != nullptr) + (scanFile != nullptr) + (serveSocket != nullptr) +
+      (freeSpaceFile != nullptr) + reverseFlag + sampleMode +
+      listHostsMode + generateFlag;
+   if(modes > 1) {
+      std::cerr << gettext("ERROR: Only one mode can be given at once!") << "\n";
+      exit(1);
+   }
+
+   // ====== Annotations are only shown for a single address ================
+   if( (annotationsFile != nullptr) && (modes > 0) && (serveSocket == nullptr) ) {
+      std::cerr << gettext("ERROR: --annotations can only be used for a single address or with --serve!") << "\n";
+      exit(1);
+   }
+
+   // ====== Prefix list modes ==============================================
+   if(overlapsMode) {
+      if(optind >= argc) {
+         usage(argv[0], 1);
+      }
+      return printOverlaps(std::cout, outputFormat, argc - optind, &argv[optind]) ? 0 : 1;
+   }
+   if(coverageMode) {
+      if(optind >= argc) {
+         usage(argv[0], 1);
+      }
+      return printCoverage(std::cout, outputFormat, argc - optind, &argv[optind],
+                           dense, intersection, blockLength) ? 0 : 1;
+   }
+   if(statsMode) {
+      if(optind >= argc) {
+         usage(argv[0], 1);
+      }
+      return printStatistics(std::cout, outputFormat, argc - optind, &argv[optind]) ? 0 : 1;
+   }
+   if(treeMode) {
+      if(optind >= argc) {
+         usage(argv[0], 1);
+      }
+      return printPrefixTree(std::cout, outputFormat, argc - optind, &argv[optind]) ? 0 : 1;
+   }
+   if(aclFile != nullptr) {
+      if(optind == argc) {
+         return printAccessList(std::cout, outputFormat, aclFile, expand) ? 0 : 1;
+      }
+      if(optind + 1 != argc) {
+         usage(argv[0], 1);
+      }
+      return printAccessListMatches(std::cout, outputFormat, aclFile, argv[optind]) ? 0 : 1;
+   }
+   if(rangesFile != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      return printAddressRanges(std::cout, outputFormat, rangesFile) ? 0 : 1;
+   }
+   if(geoStatsFile != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      return printGeoIPStatistics(std::cout, outputFormat, geoStatsFile, top) ? 0 : 1;
+   }
+   if(mcastMACFile != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      return printMulticastMACs(std::cout, outputFormat, mcastMACFile, collisions) ? 0 : 1;
+   }
+   if(mcastGroupsMAC != nullptr) {
+      if(optind + 1 < argc) {
+         usage(argv[0], 1);
+      }
+      return printMulticastGroups(std::cout, outputFormat, mcastGroupsMAC,
+                                  (optind < argc) ? argv[optind] : nullptr) ? 0 : 1;
+   }
+   if(resolveFile != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      sockaddr_union nameServerAddress;
+      if(nameServer != nullptr) {
+         if(!parseNameServer(nameServer, nameServerAddress)) {
+            std::cerr << format(gettext("ERROR: Invalid address %s!"), nameServer) << "\n";
+            exit(1);
+         }
+      }
+      else {
+         getSystemNameServer(nameServerAddress);
+      }
+      return printResolvedNames(std::cout, outputFormat, resolveFile, nameServerAddress,
+                                ipv4PrefixLength, ipv6PrefixLength) ? 0 : 1;
+   }
+   if(solicitedFile != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      return printSolicitedNodeLoad(std::cout, outputFormat, solicitedFile,
+                                    ipv6PrefixLength, (unsigned int)tableSize,
+                                    collisions) ? 0 : 1;
+   }
+   if(compileAnnotationsFile != nullptr) {
+      if(optind + 1 != argc) {
+         usage(argv[0], 1);
+      }
+      return compileAnnotationIndex(compileAnnotationsFile, argv[optind]) ? 0 : 1;
+   }
+   AnnotationIndex  annotationIndex;
+   AnnotationIndex* annotations = nullptr;
+   if(annotationsFile != nullptr) {
+      if(!annotationIndex.open(annotationsFile)) {
+         exit(1);
+      }
+      annotations = &annotationIndex;
+   }
+   if(diffFile != nullptr) {
+      if(optind + 1 != argc) {
+         usage(argv[0], 1);
+      }
+      return printPrefixDiff(std::cout, outputFormat, diffFile, argv[optind]) ? 0 : 1;
+   }
+   if(slaacFile != nullptr) {
+      if(optind + 1 != argc) {
+         usage(argv[0], 1);
+      }
+      return printSLAACAddresses(std::cout, outputFormat, slaacFile, argv[optind]) ? 0 : 1;
+   }
+   if(extractMACFile != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      return printEmbeddedMACs(std::cout, outputFormat, extractMACFile) ? 0 : 1;
+   }
+   if(serveSocket != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      initialiseI18N();   // Set up once, not on the first query
+      return runServer(serveSocket,
+                       [noGeoIPLookup, annotations](const std::string& query, std::ostream& response) {
+                          return handleQuery(query, response, noGeoIPLookup, annotations);
+                       }) ? 0 : 1;
+   }
+   if(nat64File != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
       }
+      return printNAT64Mapping(std::cout, outputFormat, nat64File, translationPrefix) ? 0 : 1;
    }
+   if(scanFile != nullptr) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      return scanAddresses(std::cout, outputFormat, scanFile,
+                           ipv4PrefixLength, ipv6PrefixLength) ? 0 : 1;
+   }
+
+   if( (generateFlag) && (generateMode == GM_UniqueLocal) ) {
+      if(optind != argc) {
+         usage(argv[0], 1);
+      }
+      return generateAddresses(std::cout, outputFormat, generateMode, Prefix { },
+                               count, (uniqueLocal > 1)) ? 0 : 1;
+   }
+
+   if( (optind + 1 != argc) && (optind + 2 != argc) ) {
+      usage(argv[0], 1);
+   }
+
+   int            prefix;
+   sockaddr_union address;
+   sockaddr_union netmask;
+   if(!readAddressArguments(std::cerr, argv[optind],
+                            (optind + 1 < argc) ? argv[optind + 1] : nullptr,
+                            address, netmask, prefix)) {
+      exit(1);
+   }
+
+
+   // ====== Unique Local IPv4 address generation ===========================
+   if( (uniqueLocal > 0) && (!generateFlag) ) {
+      generateUniqueLocal(address, (uniqueLocal > 1));
+   }
+
+
+   // ====== Calculate network address ======================================
+   AddressValue addressValue;
+   AddressValue netmaskValue;
+   addressToValue(address, addressValue);
+   addressToValue(netmask, netmaskValue);
+   const sockaddr_union network = replaceAddress(address, addressValue & netmaskValue);
+
+   // ====== Free-space finder ==============================================
+   if(freeSpaceFile != nullptr) {
+      Prefix parent;
+      makePrefix(network, prefix, parent);
+      return printFreeSpace(std::cout, outputFormat, parent, freeSpaceFile, minSize) ? 0 : 1;
+   }
+
+   // ====== Reverse zone names =============================================
+   if(reverseFlag) {
+      Prefix parent;
+      makePrefix(network, prefix, parent);
+      return printReverseZone(std::cout, outputFormat, reverseMode, parent) ? 0 : 1;
+   }
+
+   // ====== Deterministic host sampling ====================================
+   if(sampleMode) {
+      Prefix parent;
+      makePrefix(network, prefix, parent);
+      return sampleHosts(std::cout, outputFormat, parent, sampleSize, seed) ? 0 : 1;
+   }
+
+   // ====== Host enumeration ===============================================
+   if(listHostsMode) {
+      Prefix parent;
+      makePrefix(network, prefix, parent);
+      return listHosts(std::cout, outputFormat, parent) ? 0 : 1;
+   }
+
+   // ====== Random address generation ======================================
+   if(generateFlag) {
+      Prefix parent;
+      makePrefix(network, prefix, parent);
+      return generateAddresses(std::cout, outputFormat, generateMode, parent,
+                               count, (uniqueLocal > 1)) ? 0 : 1;
+   }
+
+   // ====== Print results ==================================================
+   printSubnet(std::cout, address, netmask, prefix,
+               colourMode, noReverseLookup, noGeoIPLookup, annotations);
+   return 0;
 }
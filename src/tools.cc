@@ -32,9 +32,11 @@
 #include <arpa/inet.h>
 #include <cassert>
 #include <cctype>
+#include <clocale>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <fcntl.h>
 #include <iostream>
 #include <netdb.h>
@@ -62,6 +64,20 @@ unsigned long long getMicroTime()
 }
 
 
+// ###### Set up locale and message catalogue ###############################
+bool I18NInitialised = false;
+
+void setupI18N()
+{
+   I18NInitialised = true;
+   if(setlocale(LC_ALL, "") == nullptr) {
+      setlocale(LC_ALL, "C.UTF-8");   // "C" should exist on all systems!
+   }
+   bindtextdomain("subnetcalc", nullptr);
+   textdomain("subnetcalc");
+}
+
+
 // ###### Length-checking strcpy() ##########################################
 bool safestrcpy(char* dest, const char* src, const size_t size)
 {
@@ -101,14 +117,109 @@ bool checkIPv6()
 }
 
 
-// ###### Does the given address have a translation prefix? #################
-bool hasTranslationPrefix(const sockaddr_in6* address)
+// ====== Network-specific prefix (NSP) for IPv4/IPv6 translation ==========
+static in6_addr     TranslationPrefix;
+static unsigned int TranslationPrefixLength = 0;
+
+
+// ###### Is the given length a valid RFC 6052 prefix length? ###############
+bool isTranslationPrefixLength(const unsigned int prefixLength)
 {
+   switch(prefixLength) {
+      case 32:
+      case 40:
+      case 48:
+      case 56:
+      case 64:
+      case 96:
+         return true;
+   }
+   return false;
+}
+
+
+// ###### Set network-specific translation prefix ###########################
+bool setTranslationPrefix(const in6_addr& prefix, const unsigned int prefixLength)
+{
+   if(!isTranslationPrefixLength(prefixLength)) {
+      return false;
+   }
+   TranslationPrefix       = prefix;
+   TranslationPrefixLength = prefixLength;
+   return true;
+}
+
+
+// ###### Get translation prefix length of the given address ################
+// Returns 0, if the address does not have a translation prefix. Besides the
+// configured network-specific prefix, the well-known prefix 64:ff9b::/96
+// (RFC 6052) and the local-use prefix 64:ff9b:1::/48 (RFC 8215; assuming
+// the IPv4 address in the last 32 bits) are recognised.
+unsigned int getTranslationPrefixLength(const sockaddr_in6* address)
+{
+   if(TranslationPrefixLength > 0) {
+      const unsigned int bytes = TranslationPrefixLength / 8;
+      if(memcmp(&address->sin6_addr.s6_addr, &TranslationPrefix.s6_addr, bytes) == 0) {
+         return TranslationPrefixLength;
+      }
+   }
+
    const uint16_t word0 = (address->sin6_addr.s6_addr[0] << 8) | address->sin6_addr.s6_addr[1];
    const uint16_t word1 = (address->sin6_addr.s6_addr[2] << 8) | address->sin6_addr.s6_addr[3];
    const uint16_t word2 = (address->sin6_addr.s6_addr[4] << 8) | address->sin6_addr.s6_addr[5];
 
-   return ( (word0 == 0x64) && (word1 == 0xff9b) && (word2 <= 1) );
+   return ( (word0 == 0x64) && (word1 == 0xff9b) && (word2 <= 1) ) ? 96 : 0;
+}
+
+
+// ###### Does the given address have a translation prefix? #################
+bool hasTranslationPrefix(const sockaddr_in6* address)
+{
+   return (getTranslationPrefixLength(address) > 0);
+}
+
+
+// ###### Embed IPv4 address into IPv6 address (RFC 6052) ###################
+// The IPv4 address follows the prefix, skipping bits 64 to 71 ("u" octet).
+bool embedIPv4Address(in6_addr&          ipv6address,
+                      const in6_addr&    prefix,
+                      const unsigned int prefixLength,
+                      const in_addr&     ipv4address)
+{
+   if(!isTranslationPrefixLength(prefixLength)) {
+      return false;
+   }
+   const uint8_t* ipv4 = (const uint8_t*)&ipv4address.s_addr;
+   memset(&ipv6address, 0, sizeof(ipv6address));
+   memcpy(&ipv6address.s6_addr, &prefix.s6_addr, prefixLength / 8);
+   unsigned int j = prefixLength / 8;
+   for(unsigned int i = 0; i < 4; i++) {
+      if(j == 8) {
+         j++;
+      }
+      ipv6address.s6_addr[j++] = ipv4[i];
+   }
+   return true;
+}
+
+
+// ###### Extract IPv4 address from IPv6 address (RFC 6052) #################
+bool extractIPv4Address(const in6_addr&    ipv6address,
+                        const unsigned int prefixLength,
+                        in_addr&           ipv4address)
+{
+   if(!isTranslationPrefixLength(prefixLength)) {
+      return false;
+   }
+   uint8_t* ipv4 = (uint8_t*)&ipv4address.s_addr;
+   unsigned int j = prefixLength / 8;
+   for(unsigned int i = 0; i < 4; i++) {
+      if(j == 8) {
+         j++;
+      }
+      ipv4[i] = ipv6address.s6_addr[j++];
+   }
+   return true;
 }
 
 
@@ -126,105 +237,246 @@ size_t getSocklen(const struct sockaddr* address)
 }
 
 
-// ###### Format an IPv6-embedded IPv6 address ##############################
-inline bool formatEmbeddedAddress(const struct sockaddr_in6* ipv6address,
-                                  char*                      str,
-                                  const size_t               maxlen)
+// ###### Decimal strings of all octet values ###############################
+struct OctetStringTable {
+   char    Text[256][4];
+   uint8_t Length[256];
+
+   constexpr OctetStringTable() : Text(), Length() {
+      for(unsigned int i = 0; i < 256; i++) {
+         unsigned int n = 0;
+         if(i >= 100) {
+            Text[i][n++] = (char)('0' + (i / 100));
+         }
+         if(i >= 10) {
+            Text[i][n++] = (char)('0' + ((i / 10) % 10));
+         }
+         Text[i][n++] = (char)('0' + (i % 10));
+         Length[i]    = (uint8_t)n;
+      }
+   }
+};
+
+static constexpr OctetStringTable OctetStrings;
+
+// Upper bound of address2string()'s output: "[" IPv6 address "%" scope
+// "]:" port, with some slack for the unchecked copies of the writers.
+static const size_t MaxAddressStringLength = 1 + INET6_ADDRSTRLEN + 1 + IFNAMSIZ + 16;
+
+
+// ###### Write dotted-decimal IPv4 address #################################
+// Always copies 3 characters per octet, so the buffer needs 2 bytes slack.
+static inline char* writeIPv4Address(char* str, const uint8_t* octets)
+{
+   for(unsigned int i = 0; i < 4; i++) {
+      if(i > 0) {
+         *str++ = '.';
+      }
+      memcpy(str, OctetStrings.Text[octets[i]], 3);
+      str += OctetStrings.Length[octets[i]];
+   }
+   return str;
+}
+
+
+// ###### Write 16-bit group in hexadecimal without leading zeros ###########
+static inline char* writeHexGroup(char* str, const unsigned int value)
 {
-   struct in6_addr prefix = ipv6address->sin6_addr;
-
-   // Set the suffix to a predictable value.
-   prefix.s6_addr[12] = 0xff;
-   prefix.s6_addr[13] = 0xff;
-   prefix.s6_addr[14] = 0xff;
-   prefix.s6_addr[15] = 0xff;
-   if(inet_ntop(AF_INET6, &prefix, str, maxlen) == nullptr) {
-      return false;
+   static const char hexDigits[] = "0123456789abcdef";
+   int shift = 12;
+   while( (shift > 0) && ((value >> shift) == 0) ) {
+      shift -= 4;
    }
+   for( ; shift >= 0; shift -= 4) {
+      *str++ = hexDigits[(value >> shift) & 0xf];
+   }
+   return str;
+}
 
-   // Overwrite the predictable suffix with the IPv4 address.
-   const size_t   pl    = strnlen(str, maxlen) - 9;
-   const uint32_t upper = (ipv6address->sin6_addr.s6_addr[12] << 8) | ipv6address->sin6_addr.s6_addr[13];
-   const uint32_t lower = (ipv6address->sin6_addr.s6_addr[14] << 8) | ipv6address->sin6_addr.s6_addr[15];
 
-   const uint32_t suffix = htonl((upper << 16) | lower);
-   return inet_ntop(AF_INET, &suffix, str + pl, maxlen - pl) != nullptr;
+// ###### Write unsigned number in decimal ##################################
+static inline char* writeDecimal(char* str, unsigned int value)
+{
+   char  digits[16];
+   char* d = digits;
+   do {
+      *d++ = (char)('0' + (value % 10));
+      value /= 10;
+   } while(value > 0);
+   while(d > digits) {
+      *str++ = *--d;
+   }
+   return str;
 }
 
 
-// ###### Format an IPv6 address ############################################
-static inline bool formatIPv6Address(const struct sockaddr_in6* ipv6address,
-                                     char*                      str,
-                                     const size_t               maxlen)
+// ###### Write IPv6 address (RFC 5952) #####################################
+// The longest run of at least two zero groups (the first one on ties) is
+// compressed to "::", and hexadecimal digits are written in lower case.
+// IPv4-compatible and IPv4-mapped addresses are written with dotted-decimal
+// suffix, like inet_ntop() does. So are IPv4-embedded addresses with a /96
+// translation prefix (RFC 6052, Section 2.4); for the other translation
+// prefix lengths, the IPv4 address is not octet-aligned within the groups.
+static char* writeIPv6Address(char* str, const struct sockaddr_in6* ipv6address)
 {
-   if(hasTranslationPrefix(ipv6address)) {
-      return formatEmbeddedAddress(ipv6address, str, maxlen);
+   const uint8_t* bytes = ipv6address->sin6_addr.s6_addr;
+   unsigned int   groups[8];
+   for(unsigned int i = 0; i < 8; i++) {
+      groups[i] = ((unsigned int)bytes[2 * i] << 8) | bytes[2 * i + 1];
    }
 
-   return (inet_ntop(AF_INET6, &ipv6address->sin6_addr, str, maxlen) != nullptr);
+   // ====== Find longest run of zero groups ================================
+   auto findZeroRun = [&](const unsigned int count,
+                          int& bestStart, int& bestLength) {
+      bestStart  = -1;
+      bestLength = 0;
+      int start  = -1;
+      for(unsigned int i = 0; i < count; i++) {
+         if(groups[i] == 0) {
+            if(start < 0) {
+               start = (int)i;
+            }
+            if((int)i - start + 1 > bestLength) {
+               bestStart  = start;
+               bestLength = (int)i - start + 1;
+            }
+         }
+         else {
+            start = -1;
+         }
+      }
+      if(bestLength < 2) {
+         bestStart  = -1;
+         bestLength = 0;
+      }
+   };
+   int bestStart;
+   int bestLength;
+   findZeroRun(8, bestStart, bestLength);
+   const bool dottedSuffix =
+      ( (bestStart == 0) &&
+        ( (bestLength == 6) || ((bestLength == 5) && (groups[5] == 0xffff)) ) ) ||
+      (getTranslationPrefixLength(ipv6address) == 96);
+   const unsigned int count = (dottedSuffix) ? 6 : 8;
+   if(dottedSuffix) {
+      findZeroRun(count, bestStart, bestLength);
+   }
+
+   // ====== Write groups ===================================================
+   for(int i = 0; i < (int)count; ) {
+      if(i == bestStart) {
+         *str++ = ':';
+         *str++ = ':';
+         i += bestLength;
+         continue;
+      }
+      if( (i > 0) && (i != bestStart + bestLength) ) {
+         *str++ = ':';
+      }
+      str = writeHexGroup(str, groups[i++]);
+   }
+   if(dottedSuffix) {
+      if(str[-1] != ':') {
+         *str++ = ':';
+      }
+      str = writeIPv4Address(str, &bytes[12]);
+   }
+   return str;
+}
+
+
+// ###### Get interface name of a scope ID ##################################
+// if_indextoname() needs a system call, so the names are cached per thread.
+// The entries expire after a few seconds, to notice renamed interfaces.
+struct InterfaceNameCacheEntry {
+   unsigned int Index;
+   time_t       Expiry;
+   char         Name[IFNAMSIZ];   // Empty for an unknown index
+};
+
+static const char* getInterfaceName(const unsigned int index)
+{
+   static thread_local InterfaceNameCacheEntry cache[8];
+   InterfaceNameCacheEntry& entry = cache[index % 8];
+   const time_t             now   = time(nullptr);
+   if( (entry.Expiry <= now) || (entry.Index != index) ) {
+      if(if_indextoname(index, entry.Name) == nullptr) {
+         entry.Name[0] = 0x00;
+      }
+      entry.Index  = index;
+      entry.Expiry = now + 5;
+   }
+   return entry.Name;
 }
 
 
 // ###### Convert address to string #########################################
+// The address is written directly into the buffer, without temporary
+// strings and shared static buffers, so that this function is reentrant.
+// If the buffer is too small, the result is truncated.
 bool address2string(const struct sockaddr* address,
                     char*                  buffer,
                     const size_t           length,
                     const bool             port,
                     const bool             hideScope)
 {
-   const struct sockaddr_in*  ipv4address;
-   const struct sockaddr_in6* ipv6address;
-   char                       str[128];
-   char                       scope[IFNAMSIZ + 16];
-   char                       ifnamebuffer[IFNAMSIZ];
-   const char*                ifname;
+   char  local[MaxAddressStringLength];
+   char* str = (length >= sizeof(local)) ? buffer : local;
 
    switch(address->sa_family) {
       case AF_INET:
-         ipv4address = (const struct sockaddr_in*)address;
-         if(port) {
-            snprintf(buffer, length, "%s:%d",
-                     inet_ntoa(ipv4address->sin_addr),
-                     ntohs(ipv4address->sin_port));
-         }
-         else {
-            snprintf(buffer, length, "%s", inet_ntoa(ipv4address->sin_addr));
+         {
+            const struct sockaddr_in* ipv4address = (const struct sockaddr_in*)address;
+            str = writeIPv4Address(str, (const uint8_t*)&ipv4address->sin_addr.s_addr);
+            if(port) {
+               *str++ = ':';
+               str = writeDecimal(str, ntohs(ipv4address->sin_port));
+            }
          }
-         return true;
+         break;
 
       case AF_INET6:
-         ipv6address = (const struct sockaddr_in6*)address;
-         if( (!hideScope) &&
-             (IN6_IS_ADDR_LINKLOCAL(&ipv6address->sin6_addr) ||
-              IN6_IS_ADDR_MC_LINKLOCAL(&ipv6address->sin6_addr)) ) {
-            ifname = if_indextoname(ipv6address->sin6_scope_id, ifnamebuffer);
-            if(ifname != nullptr) {
-               snprintf(scope, sizeof(scope), "%%%s", ifname);
+         {
+            const struct sockaddr_in6* ipv6address = (const struct sockaddr_in6*)address;
+            if(port) {
+               *str++ = '[';
             }
-            else {
-               snprintf(scope, sizeof(scope), "%%%u", ipv6address->sin6_scope_id);
+            str = writeIPv6Address(str, ipv6address);
+            if( (!hideScope) &&
+                (IN6_IS_ADDR_LINKLOCAL(&ipv6address->sin6_addr) ||
+                 IN6_IS_ADDR_MC_LINKLOCAL(&ipv6address->sin6_addr)) ) {
+               *str++ = '%';
+               const char* ifname = getInterfaceName(ipv6address->sin6_scope_id);
+               if(ifname[0] != 0x00) {
+                  const size_t ifnameLength = strlen(ifname);
+                  memcpy(str, ifname, ifnameLength);
+                  str += ifnameLength;
+               }
+               else {
+                  str = writeDecimal(str, ipv6address->sin6_scope_id);
+               }
             }
-         }
-         else {
-            scope[0] = 0x00;
-         }
-         if(formatIPv6Address(ipv6address, str, sizeof(str))) {
             if(port) {
-               snprintf(buffer, length,
-                        "[%s%s]:%d", str, scope, ntohs(ipv6address->sin6_port));
+               *str++ = ']';
+               *str++ = ':';
+               str = writeDecimal(str, ntohs(ipv6address->sin6_port));
             }
-            else {
-               snprintf(buffer, length, "%s%s", str, scope);
-            }
-            return true;
          }
          break;
 
       case AF_UNSPEC:
          safestrcpy(buffer, "(unspecified)", length);
          return true;
+
+      default:
+         return false;
    }
-   return false;
+
+   *str = 0x00;
+   if( (length < sizeof(local)) && (length > 0) ) {
+      safestrcpy(buffer, local, length);
+   }
+   return true;
 }
 
 
@@ -316,13 +568,14 @@ bool string2address(const char*           string,
    if(isNumeric) {
       hints.ai_flags |= AI_NUMERICHOST;
    }
-#ifndef AI_IDN
    else {
+      initialiseI18N();   // IDN conversion depends on the locale's charset
+#ifndef AI_IDN
       if(idn2_to_ascii_8z(host, &punycode, 0) != IDN2_OK) {
          punycode = nullptr;
       }
-   }
 #endif
+   }
 
    // First try IPv6 ...
    hints.ai_family = AF_INET6;
@@ -43,6 +43,46 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 
+// ====== Lazy i18n initialisation ==========================================
+// The locale and the message catalogue are set up on first use only, i.e.
+// runs that never print translated text or resolve names do not pay for it.
+extern bool I18NInitialised;
+void setupI18N();
+
+inline void initialiseI18N()
+{
+   if(!I18NInitialised) {
+      setupI18N();
+   }
+}
+
+#ifdef ENABLE_NLS
+#include <libintl.h>
+
+inline char* translate(const char* string)
+{
+   initialiseI18N();
+   return gettext(string);
+}
+
+inline char* translate(const char* singular, const char* plural,
+                       const unsigned long n)
+{
+   initialiseI18N();
+   return ngettext(singular, plural, n);
+}
+
+#undef gettext
+#undef ngettext
+#define gettext(string) translate(string)
+#define ngettext(singular, plural, n) translate(singular, plural, n)
+#else
+#define bindtextdomain(domain, dirname) { }
+#define textdomain(domain) { }
+#define gettext(string) string
+#define ngettext(singular, plural, n) ((n) == 1 ? (singular) : (plural))
+#endif
+
 
 unsigned long long getMicroTime();
 
@@ -58,7 +98,17 @@ union sockaddr_union {
 };
 
 bool checkIPv6();
+bool isTranslationPrefixLength(const unsigned int prefixLength);
+bool setTranslationPrefix(const in6_addr& prefix, const unsigned int prefixLength);
+unsigned int getTranslationPrefixLength(const sockaddr_in6* address);
 bool hasTranslationPrefix(const sockaddr_in6* address);
+bool embedIPv4Address(in6_addr&          ipv6address,
+                      const in6_addr&    prefix,
+                      const unsigned int prefixLength,
+                      const in_addr&     ipv4address);
+bool extractIPv4Address(const in6_addr&    ipv6address,
+                        const unsigned int prefixLength,
+                        in_addr&           ipv4address);
 size_t getSocklen(const struct sockaddr* address);
 bool address2string(const struct sockaddr* address,
                     char*                  buffer,